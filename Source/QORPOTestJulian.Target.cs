@@ -10,6 +10,7 @@ public class QORPOTestJulianTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+		bUseIris = true;
 		ExtraModuleNames.Add("QORPOTestJulian");
 	}
 }
@@ -4,7 +4,7 @@
  * @file BaseEnemy.cpp
  * @brief Implements the core logic for the ABaseEnemy class, which serves as the base class for all enemy pawns in the game.
  *
- * This class handles enemy initialization, damage and healing processing, AI movement, overlap interactions,
+ * This class handles enemy initialization, damage and healing processing, AI movement, contact damage,
  * health changes, and networked spawning. It is designed to be extended for specific enemy types and supports
  * both C++ and Blueprint customization.
  */
@@ -14,15 +14,21 @@
 #include "NavigationSystem.h"
 #include "../../Core/Public/ShooterPlayerController.h"
 #include "../Public/ShooterPlayer.h"
+#include "../../Subsystems/Public/LagCompensationSubsystem.h"
+#include "../../Subsystems/Public/DamageSubsystem.h"
+#include "../../Subsystems/Public/ContactDamageSubsystem.h"
+#include "../../Subsystems/Public/NetActivitySubsystem.h"
 
 /**
  * Default constructor.
  * Initializes all components, sets up collision, movement, and replication properties.
+ * The mesh only blocks projectiles and generates no overlap events, since contacts with the players are detected by the
+ * contact damage subsystem; it is the volume hit by rays, projectiles and explosions. The box blocks the world and players
+ * through its own object channel, so no weapon query ever stops on it before reaching the mesh.
  */
 ABaseEnemy::ABaseEnemy()
 {
     PrimaryActorTick.bCanEverTick = true;
-    bAlwaysRelevant = true;
     SetReplicates(true);
     SetReplicateMovement(true);
     AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
@@ -31,16 +37,13 @@ ABaseEnemy::ABaseEnemy()
     USceneComponent* MainSceneComponent = GetRootComponent();
 
     MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(FName("MeshComponent"));
-    MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-    MeshComponent->SetCollisionObjectType(ECC_Pawn);
-    MeshComponent->SetCollisionResponseToAllChannels(ECR_Overlap);
+    MeshComponent->SetCollisionProfileName(FName("EnemyHitVolume"));
+    MeshComponent->SetGenerateOverlapEvents(false);
     MeshComponent->SetupAttachment(MainSceneComponent);
 
     BoxComponent = CreateDefaultSubobject<UBoxComponent>(FName("BoxComponent"));
     BoxComponent->bDynamicObstacle = true;
-    BoxComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-    BoxComponent->SetCollisionObjectType(ECC_Pawn);
-    BoxComponent->SetCollisionResponseToAllChannels(ECR_Block);
+    BoxComponent->SetCollisionProfileName(FName("EnemyBlocker"));
     BoxComponent->SetupAttachment(MeshComponent);
 
     ParticleComponent = CreateDefaultSubobject<UParticleSystemComponent>(FName("ParticleComponent"));
@@ -63,8 +66,8 @@ ABaseEnemy::ABaseEnemy()
 
 /**
  * Processes incoming damage or healing events for this enemy.
- * Handles different types of damage events (point, radial, healing) and updates health accordingly.
- * Awards points to the player if the enemy is defeated.
+ * Healing is applied right away; damage is queued in the damage subsystem, which applies the net health change
+ * of the frame in one batch and reports the defeat through HandleHealthDepleted.
  *
  * @param DamageAmount The amount of damage.
  * @param DamageEvent The event describing the type of damage or healing.
@@ -80,54 +83,16 @@ float ABaseEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent
         return DamageResult;
     }
 
-    bool bSuccessReaction = false;
-    switch (DamageEvent.GetTypeID())
-    {
-    case FDamageEvent::ClassID:
-    {
-        DamageResult = -abs(DamageAmount);
-        bSuccessReaction = AttributesComponent->HealthReaction(-abs(DamageAmount));
-
-        break;
-    }
-    case FPointDamageEvent::ClassID:
-    {
-        DamageResult = -abs(DamageAmount);
-        bSuccessReaction = AttributesComponent->HealthReaction(-abs(DamageAmount));
-
-        break;
-    }
-    case FRadialDamageEvent::ClassID:
-    {
-        const FRadialDamageEvent& RadialEvent = static_cast<const FRadialDamageEvent&>(DamageEvent);
-        const FVector& CurrentPosition = GetActorLocation();
-        const FVector& RadialPosition = RadialEvent.Origin;
-        DamageResult = abs(RadialEvent.Params.BaseDamage * RadialEvent.Params.GetDamageScale(FVector::Distance(CurrentPosition, RadialPosition)));
-        bSuccessReaction = AttributesComponent->HealthReaction(-DamageResult);
-        if (IsValid(FloatingMovement))
-        {
-            FloatingMovement->AddRadialImpulse(RadialPosition, RadialEvent.Params.GetMaxRadius(), DamageResult * DamageAmount, RIF_Linear, true);
-        }
-
-        break;
-    }
-    case FHealEvent::ClassID:
+    if (DamageEvent.GetTypeID() == FHealEvent::ClassID)
     {
         const FHealEvent& HealEvent = static_cast<const FHealEvent&>(DamageEvent);
-        bSuccessReaction = AttributesComponent->HealthReaction(abs(DamageAmount));
-        DamageResult = bSuccessReaction ? HealEvent.HealSuccess : DamageAmount;
-
-        break;
-    }
-    default:
-        break;
+        return AttributesComponent->HealthReaction(abs(DamageAmount)) ? HealEvent.HealSuccess : DamageAmount;
     }
 
-    AShooterPlayerController* PlayerController = Cast<AShooterPlayerController>(EventInstigator);
-    const float HealthResult = AttributesComponent->GetHealth();
-    if (IsValid(PlayerController) && bSuccessReaction && HealthResult <= 0.0f)
+    UDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UDamageSubsystem>();
+    if (IsValid(DamageSubsystem))
     {
-        PlayerController->UpdateScore(Points);
+        DamageResult = DamageSubsystem->QueueDamage(UDamageSubsystem::MakeQueuedDamage(this, AttributesComponent, DamageAmount, DamageEvent, EventInstigator));
     }
 
     return DamageResult;
@@ -135,7 +100,8 @@ float ABaseEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent
 
 /**
  * Called when the game starts or when spawned.
- * Initializes enabled types, binds health change events, and populates the list of targets.
+ * Initializes enabled types, binds health change events, populates the list of targets,
+ * registers the enemy for contact damage and, on the server, for adaptive net update frequency.
  */
 void ABaseEnemy::BeginPlay()
 {
@@ -147,6 +113,7 @@ void ABaseEnemy::BeginPlay()
     if (IsValid(AttributesComponent))
     {
         AttributesComponent->OnHealthChanged.AddUniqueDynamic(this, &ABaseEnemy::HandleHealthChanged);
+        AttributesComponent->OnHealthDepleted.AddUniqueDynamic(this, &ABaseEnemy::HandleHealthDepleted);
     }
 
     for (TActorIterator<AShooterPlayer> I(GetWorld()); I; ++I)
@@ -157,6 +124,18 @@ void ABaseEnemy::BeginPlay()
         }
     }
 
+    UContactDamageSubsystem* ContactDamage = GetWorld()->GetSubsystem<UContactDamageSubsystem>();
+    if (IsValid(ContactDamage))
+    {
+        ContactDamage->RegisterEnemy(this);
+    }
+
+    UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+    if (HasAuthority() && IsValid(NetActivity))
+    {
+        NetActivity->RegisterActor(this);
+    }
+
     Execute_OnTurnEnabled(this, false);
 }
 
@@ -174,25 +153,41 @@ void ABaseEnemy::Tick(float DeltaTime)
 }
 
 /**
- * Called when another actor begins to overlap with this enemy.
- * If the overlapping actor is a valid player, applies damage and triggers health change handling.
+ * Returns the world bounds used to detect contacts with the players.
  *
- * @param OtherActor The actor that started overlapping.
+ * @param OutBounds Set to the bounds of the enemy mesh.
+ * @return True if the enemy is active and can deal contact damage.
  */
-void ABaseEnemy::NotifyActorBeginOverlap(AActor* OtherActor)
+const bool ABaseEnemy::GetContactBounds(FBox& OutBounds) const
 {
-    Super::NotifyActorBeginOverlap(OtherActor);
+    if (!bEnableStatus || !IsValid(MeshComponent))
+    {
+        return false;
+    }
 
-    if (bEnableStatus && OtherActor != this && IsValid(Cast<AShooterPlayer>(OtherActor)))
+    OutBounds = MeshComponent->Bounds.GetBox();
+
+    return true;
+}
+
+/**
+ * Handles a contact with a player detected by the contact damage subsystem.
+ * Damages the player and triggers health change handling, which makes the enemy explode and disappear.
+ *
+ * @param Target The player touched.
+ */
+void ABaseEnemy::HandleContact(AActor* Target)
+{
+    if (bEnableStatus && IsValid(Target))
     {
-        OtherActor->TakeDamage(Damage, FDamageEvent(), GetInstigatorController(), this);
+        Target->TakeDamage(Damage, FDamageEvent(), GetInstigatorController(), this);
         HandleHealthChanged(0.0f, 0.0f);
     }
 }
 
 /**
  * Called when the enemy is removed from the world.
- * Clears the OnEnemyOut delegate.
+ * Clears the OnEnemyOut delegate, stops recording the lag compensated hit volume, testing contacts and adapting the net update frequency.
  *
  * @param EndPlayReason The reason for removal.
  */
@@ -201,6 +196,24 @@ void ABaseEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
     Super::EndPlay(EndPlayReason);
 
     OnEnemyOut.Clear();
+
+    ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+    if (IsValid(LagCompensation))
+    {
+        LagCompensation->UnregisterHitVolume(this);
+    }
+
+    UContactDamageSubsystem* ContactDamage = GetWorld()->GetSubsystem<UContactDamageSubsystem>();
+    if (IsValid(ContactDamage))
+    {
+        ContactDamage->UnregisterEnemy(this);
+    }
+
+    UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+    if (IsValid(NetActivity))
+    {
+        NetActivity->UnregisterActor(this);
+    }
 }
 
 /**
@@ -230,7 +243,8 @@ void ABaseEnemy::Multicast_Spawn_Implementation(const FVector& Position, const b
 
 /**
  * Implementation of the reusable interface to enable or disable the enemy.
- * Broadcasts the OnEnemyOut event and resets movement and target if disabled.
+ * On the server, records the mesh as the enemy's lag compensated hit volume only while enabled, so pooled enemies
+ * never hold a slot. Broadcasts the OnEnemyOut event and resets movement and target if disabled.
  * Resets health if enabled.
  *
  * @param bEnabled Whether the enemy should be enabled.
@@ -239,6 +253,19 @@ void ABaseEnemy::OnTurnEnabled_Implementation(const bool bEnabled)
 {
     IReusableInterface::OnTurnEnabled_Implementation(bEnabled);
 
+    ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+    if (HasAuthority() && IsValid(LagCompensation))
+    {
+        if (bEnabled)
+        {
+            LagCompensation->RegisterHitVolume(this, MeshComponent);
+        }
+        else
+        {
+            LagCompensation->UnregisterHitVolume(this);
+        }
+    }
+
     if (HasAuthority() && !bEnabled)
     {
         OnEnemyOut.Broadcast(this);
@@ -336,4 +363,19 @@ void ABaseEnemy::HandleHealthChanged(const float HealthResult, const float Total
     }
 
     bEnableStatus = false;
+}
+
+/**
+ * Handles the damage that depleted the enemy's health.
+ * Awards points to the player responsible for the defeat.
+ *
+ * @param Instigator The controller responsible for the depleting damage.
+ */
+void ABaseEnemy::HandleHealthDepleted(AController* Instigator)
+{
+    AShooterPlayerController* PlayerController = Cast<AShooterPlayerController>(Instigator);
+    if (IsValid(PlayerController))
+    {
+        PlayerController->UpdateScore(Points);
+    }
 }
\ No newline at end of file
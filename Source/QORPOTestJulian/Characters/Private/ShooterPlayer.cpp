@@ -12,6 +12,12 @@
 #include "../../Core/Public/ShooterPlayerController.h"
 #include "../../Weapons/Public/BaseWeapon.h"
 #include "../../Interactables/Public/Door.h"
+#include "../../Subsystems/Public/LagCompensationSubsystem.h"
+#include "../../Subsystems/Public/DamageSubsystem.h"
+#include "../../Subsystems/Public/ContactDamageSubsystem.h"
+#include "../../QORPOTestJulian.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 /**
  * Default constructor.
@@ -37,12 +43,14 @@ AShooterPlayer::AShooterPlayer() : Super()
 	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
 	ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
 	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	ObjectParams.AddObjectTypesToQuery(ECC_Interactable);
 	LineTraceParams.AddIgnoredActor(this);
 }
 
 /**
  * Handles incoming damage or healing events for the player.
- * Updates health and applies radial impulses if necessary.
+ * Healing is applied right away; damage is queued in the damage subsystem, which applies the net health change
+ * of the frame in one batch. Explosion knockback is applied by the explosion subsystem.
  *
  * @param DamageAmount The amount of damage or healing.
  * @param DamageEvent The event describing the type of damage or healing.
@@ -58,42 +66,16 @@ float AShooterPlayer::TakeDamage(float DamageAmount, FDamageEvent const& DamageE
 		return DamageResult;
 	}
 
-	switch (DamageEvent.GetTypeID())
-	{
-	case FDamageEvent::ClassID:
-	{
-		DamageResult = -abs(DamageAmount);
-		AttributesComponent->HealthReaction(-abs(DamageAmount));
-		break;
-	}
-	case FPointDamageEvent::ClassID:
-	{
-		DamageResult = -abs(DamageAmount);
-		AttributesComponent->HealthReaction(-abs(DamageAmount));
-		break;
-	}
-	case FRadialDamageEvent::ClassID:
-	{
-		const FRadialDamageEvent& RadialEvent = static_cast<const FRadialDamageEvent&>(DamageEvent);
-		const FVector& CurrentPosition = GetActorLocation();
-		const FVector& RadialPosition = RadialEvent.Origin;
-		DamageResult = abs(RadialEvent.Params.BaseDamage * RadialEvent.Params.GetDamageScale(FVector::Distance(CurrentPosition, RadialPosition)));
-		AttributesComponent->HealthReaction(-DamageResult);
-		UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
-		if (IsValid(MovementComponent))
-		{
-			MovementComponent->AddRadialImpulse(RadialPosition, RadialEvent.Params.GetMaxRadius(), DamageResult * DamageAmount, RIF_Linear, true);
-		}
-		break;
-	}
-	case FHealEvent::ClassID:
+	if (DamageEvent.GetTypeID() == FHealEvent::ClassID)
 	{
 		const FHealEvent& HealEvent = static_cast<const FHealEvent&>(DamageEvent);
-		DamageResult = AttributesComponent->HealthReaction(abs(DamageAmount)) ? HealEvent.HealSuccess : DamageAmount;
-		break;
+		return AttributesComponent->HealthReaction(abs(DamageAmount)) ? HealEvent.HealSuccess : DamageAmount;
 	}
-	default:
-		break;
+
+	UDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UDamageSubsystem>();
+	if (IsValid(DamageSubsystem))
+	{
+		DamageResult = DamageSubsystem->QueueDamage(UDamageSubsystem::MakeQueuedDamage(this, AttributesComponent, DamageAmount, DamageEvent, EventInstigator));
 	}
 
 	return DamageResult;
@@ -118,7 +100,7 @@ void AShooterPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputCompo
 	PlayerInputComponent->BindKey(EKeys::LeftShift, IE_Pressed, this, &AShooterPlayer::HandleSprint);
 	PlayerInputComponent->BindKey(EKeys::C, IE_Pressed, this, &AShooterPlayer::HandleCrouch);
 	PlayerInputComponent->BindKey(EKeys::SpaceBar, IE_Pressed, this, &AShooterPlayer::HandleJump);
-	PlayerInputComponent->BindKey(EKeys::LeftMouseButton, IE_Pressed, this, &AShooterPlayer::HandleStartShoot);
+	PlayerInputComponent->BindKey(EKeys::LeftMouseButton, IE_Pressed, this, &AShooterPlayer::HandleShootPressed);
 	PlayerInputComponent->BindKey(EKeys::R, IE_Pressed, this, &AShooterPlayer::HandleReload);
 	PlayerInputComponent->BindKey(EKeys::I, IE_Pressed, this, &AShooterPlayer::HandleInteraction);
 
@@ -130,25 +112,46 @@ void AShooterPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputCompo
 	PlayerInputComponent->BindKey(EKeys::A, IE_Released, this, &AShooterPlayer::HandleMoveRight);
 	PlayerInputComponent->BindKey(EKeys::LeftShift, IE_Released, this, &AShooterPlayer::HandleSprint);
 	PlayerInputComponent->BindKey(EKeys::C, IE_Released, this, &AShooterPlayer::HandleCrouch);
-	PlayerInputComponent->BindKey(EKeys::LeftMouseButton, IE_Released, this, &AShooterPlayer::HandleStopShoot);
+	PlayerInputComponent->BindKey(EKeys::LeftMouseButton, IE_Released, this, &AShooterPlayer::HandleShootReleased);
 }
 
 /**
  * Called when the game starts or when spawned.
- * Binds health change events.
+ * Publishes the initial ammunition and, on the server, the spawn time to the owner, binds health change events,
+ * registers the capsule as the player's lag compensated hit volume in a reserved slot on the server, and as the volume enemies damage on contact.
  */
 void AShooterPlayer::BeginPlay()
 {
 	Super::BeginPlay();
 
+	UpdateReplicatedAmmunition();
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	if (HasAuthority() && IsValid(GameState))
+	{
+		SpawnServerTime = GameState->GetServerWorldTimeSeconds();
+		MARK_PROPERTY_DIRTY_FROM_NAME(AShooterPlayer, SpawnServerTime, this);
+	}
 	if (IsValid(AttributesComponent))
 	{
 		AttributesComponent->OnHealthChanged.AddUniqueDynamic(this, &AShooterPlayer::HandleHealthChange);
 	}
+
+	ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+	if (HasAuthority() && IsValid(LagCompensation))
+	{
+		LagCompensation->RegisterHitVolume(this, GetCapsuleComponent(), true);
+	}
+
+	UContactDamageSubsystem* ContactDamage = GetWorld()->GetSubsystem<UContactDamageSubsystem>();
+	if (IsValid(ContactDamage))
+	{
+		ContactDamage->RegisterTarget(this, GetCapsuleComponent());
+	}
 }
 
 /**
  * Registers properties for network replication.
+ * The ammunition and spawn time are push based and only replicated to the owner, the only client displaying them.
  *
  * @param OutLifetimeProps The array to add replicated properties to.
  */
@@ -156,12 +159,16 @@ void AShooterPlayer::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLi
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AShooterPlayer, Ammunition);
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	Params.Condition = COND_OwnerOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AShooterPlayer, ReplicatedAmmunition, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AShooterPlayer, SpawnServerTime, Params);
 }
 
 /**
  * Called every frame.
- * Handles movement input and draws debug lines for interaction.
+ * Handles movement input, updates the aim pitch of the weapon socket and draws debug lines for interaction.
  *
  * @param DeltaTime Time elapsed since the last tick.
  */
@@ -170,6 +177,7 @@ void AShooterPlayer::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 
 	AddMovementInput(GetMovementDirection());
+	UpdateAimPitch(DeltaTime);
 
 	FVector PivotPosition = IsValid(WeaponSocketComponent) ? WeaponSocketComponent->GetComponentLocation() : GetActorLocation();
 	DrawDebugLine(GetWorld(), PivotPosition,
@@ -187,6 +195,7 @@ void AShooterPlayer::NotifyActorBeginOverlap(AActor* OtherActor)
 {
 	Super::NotifyActorBeginOverlap(OtherActor);
 
+	INC_DWORD_STAT(STAT_GameplayOverlapEvents);
 	OnEquipWeapon(Cast<ABaseWeapon>(OtherActor));
 }
 
@@ -199,13 +208,11 @@ void AShooterPlayer::AddControllerPitchInput(float Value)
 {
 	const AShooterPlayerController* PlayerController = GetController<AShooterPlayerController>();
 	Super::AddControllerPitchInput(IsValid(PlayerController) && PlayerController->GetInvertPitch() ? Value : -Value);
-
-	Server_UpdatePitchView(GetControlRotation().Pitch);
 }
 
 /**
  * Called when the player is removed from the world.
- * Handles weapon unequip logic.
+ * Handles weapon unequip logic, stops recording the lag compensated hit volume and stops being a contact damage target.
  *
  * @param EndPlayReason The reason for removal.
  */
@@ -214,6 +221,18 @@ void AShooterPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 
 	OnUnequipWeapon();
+
+	ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+	if (IsValid(LagCompensation))
+	{
+		LagCompensation->UnregisterHitVolume(this);
+	}
+
+	UContactDamageSubsystem* ContactDamage = GetWorld()->GetSubsystem<UContactDamageSubsystem>();
+	if (IsValid(ContactDamage))
+	{
+		ContactDamage->UnregisterTarget(this);
+	}
 }
 
 /**
@@ -236,6 +255,33 @@ const int AShooterPlayer::GetAmmunition() const
 	return Ammunition;
 }
 
+/**
+ * Returns the currently equipped weapon.
+ *
+ * @return The equipped weapon, or nullptr if none.
+ */
+ABaseWeapon* AShooterPlayer::GetCurrentWeapon() const
+{
+	return CurrentWeapon;
+}
+
+/**
+ * Returns the time in seconds the player has been alive, from its spawn time and the synchronized server time.
+ * The server and the owning client get the same value, even if the client joined after the player spawned.
+ *
+ * @return The survive time, or zero until the spawn time has been received.
+ */
+const float AShooterPlayer::GetSurviveTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	if (SpawnServerTime < 0.0 || !IsValid(GameState))
+	{
+		return 0.0f;
+	}
+
+	return float(FMath::Max(GameState->GetServerWorldTimeSeconds() - SpawnServerTime, 0.0));
+}
+
 /**
  * Adds ammunition to the player and broadcasts the update.
  *
@@ -244,7 +290,8 @@ const int AShooterPlayer::GetAmmunition() const
 void AShooterPlayer::AddAmmunition(const int Amount)
 {
 	const int CurrentAmmunition = Ammunition;
-	Ammunition = FMath::Clamp(Ammunition + abs(Amount), 0, INT_MAX);
+	Ammunition = FMath::Clamp(Ammunition + abs(Amount), 0, int(MAX_uint16));
+	UpdateReplicatedAmmunition();
 	OnPlayerAmmunitionUpdated.Broadcast(Ammunition);
 }
 
@@ -297,13 +344,27 @@ void AShooterPlayer::OnUnequipWeapon_Implementation()
 
 /**
  * Called when the ammunition value is replicated.
- * Broadcasts the updated ammunition value.
+ * Restores the ammunition from the replicated value and broadcasts it.
  */
 void AShooterPlayer::OnReplicateAmmunition()
 {
+	Ammunition = ReplicatedAmmunition;
 	OnPlayerAmmunitionUpdated.Broadcast(Ammunition);
 }
 
+/**
+ * Packs the server ammunition into the replicated ammunition and marks it dirty for the push model.
+ */
+void AShooterPlayer::UpdateReplicatedAmmunition()
+{
+	const uint16 CurrentAmmunition = uint16(FMath::Clamp(Ammunition, 0, int(MAX_uint16)));
+	if (HasAuthority() && CurrentAmmunition != ReplicatedAmmunition)
+	{
+		ReplicatedAmmunition = CurrentAmmunition;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AShooterPlayer, ReplicatedAmmunition, this);
+	}
+}
+
 /**
  * Handles changes in the player's health.
  * Destroys the player if health reaches zero.
@@ -330,6 +391,7 @@ void AShooterPlayer::HandleReloaded(const int AmmunitionSpent)
 	if (CurrentAmmunition != Ammunition)
 	{
 		Ammunition = CurrentAmmunition;
+		UpdateReplicatedAmmunition();
 		OnPlayerAmmunitionUpdated.Broadcast(CurrentAmmunition);
 	}
 
@@ -396,12 +458,49 @@ void AShooterPlayer::HandleJump()
 	Jump();
 }
 
+/**
+ * Handles the shoot input being pressed.
+ * Broadcasts the shoot held event locally so the owning client predicts its shots, then notifies the server
+ * with the trigger sequence the press started, so both machines build the same shot identifiers.
+ */
+void AShooterPlayer::HandleShootPressed()
+{
+	uint8 TriggerSequence = 0;
+	if (!HasAuthority())
+	{
+		OnShootHeld.Broadcast(true);
+		TriggerSequence = IsValid(CurrentWeapon) ? CurrentWeapon->GetTriggerSequence() : 0;
+	}
+
+	HandleStartShoot(TriggerSequence);
+}
+
+/**
+ * Handles the shoot input being released.
+ * Broadcasts the shoot held event locally to stop the predicted shots, then notifies the server.
+ */
+void AShooterPlayer::HandleShootReleased()
+{
+	if (!HasAuthority())
+	{
+		OnShootHeld.Broadcast(false);
+	}
+
+	HandleStopShoot();
+}
+
 /**
  * Handles the start of shooting input.
- * Broadcasts the shoot held event.
+ * Aligns the trigger sequence of the weapon with the one of a remote owning client, then broadcasts the shoot held event.
+ * @param TriggerSequence The trigger sequence the press started on the owning client.
  */
-void AShooterPlayer::HandleStartShoot_Implementation()
+void AShooterPlayer::HandleStartShoot_Implementation(const uint8 TriggerSequence)
 {
+	if (!IsLocallyControlled() && IsValid(CurrentWeapon))
+	{
+		CurrentWeapon->SyncTriggerSequence(TriggerSequence);
+	}
+
 	OnShootHeld.Broadcast(true);
 }
 
@@ -458,24 +557,29 @@ void AShooterPlayer::Server_DoorInteraction_Implementation(ADoor* Door)
 }
 
 /**
- * Server-side implementation for updating the pitch view.
+ * Rotates the weapon socket to the aim pitch of the player.
+ * The pitch needs no RPC: the control rotation already reaches the server with every movement update, and the server
+ * replicates it to the other clients as the pawn's view pitch, quantized to a byte and only when it changes.
+ * Those clients interpolate towards it, since it arrives at the net update rate of the pawn.
  *
- * @param PitchInput The pitch value to update.
+ * @param DeltaTime Time elapsed since the last update.
  */
-void AShooterPlayer::Server_UpdatePitchView_Implementation(const float PitchInput)
+void AShooterPlayer::UpdateAimPitch(const float DeltaTime)
 {
-	Multicast_UpdatePitchView(PitchInput);
-}
+	if (!IsValid(WeaponSocketComponent))
+	{
+		return;
+	}
 
-/**
- * Multicast implementation for updating the pitch view on all clients.
- *
- * @param PitchInput The pitch value to update.
- */
-void AShooterPlayer::Multicast_UpdatePitchView_Implementation(const float PitchInput)
-{
-	if (IsValid(WeaponSocketComponent))
+	const float CurrentPitch = FRotator::NormalizeAxis(WeaponSocketComponent->GetRelativeRotation().Pitch);
+	float Pitch = FRotator::NormalizeAxis(GetControlRotation().Pitch);
+	if (!HasAuthority() && !IsLocallyControlled())
+	{
+		Pitch = FMath::FInterpTo(CurrentPitch, FRotator::NormalizeAxis(GetBaseAimRotation().Pitch), DeltaTime, AimPitchInterpSpeed);
+	}
+
+	if (!FMath::IsNearlyEqual(Pitch, CurrentPitch))
 	{
-		WeaponSocketComponent->SetRelativeRotation(FRotator(PitchInput, 0.0f, 0.0f));
+		WeaponSocketComponent->SetRelativeRotation(FRotator(Pitch, 0.0f, 0.0f));
 	}
 }
\ No newline at end of file
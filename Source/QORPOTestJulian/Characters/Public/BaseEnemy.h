@@ -26,7 +26,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyOut, ABaseEnemy*, Enemy);
  * This class provides core functionality for enemy actors, including:
  * - Health and damage handling
  * - AI movement and targeting
- * - Overlap and interaction logic
+ * - Contact damage and interaction logic
  * - Networked spawning and state management
  * - Integration with reusable object systems
  * 
@@ -67,6 +67,21 @@ public:
 	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Spawn")
 	void Multicast_Spawn(const FVector& Position, const bool bEnable = true);
 
+	/**
+	 * Returns the world bounds used to detect contacts with the players.
+	 * @param OutBounds Set to the bounds of the enemy mesh.
+	 * @return True if the enemy is active and can deal contact damage.
+	 */
+	const bool GetContactBounds(FBox& OutBounds) const;
+
+	/**
+	 * Handles a contact with a player detected by the contact damage subsystem.
+	 * Damages the player and makes the enemy explode.
+	 * @param Target The player touched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void HandleContact(AActor* Target);
+
 protected:
     /** Static mesh component representing the enemy's visual appearance. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -112,7 +127,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Interaction", meta = (ClampMin = 0.0f, ClampMax = 1000.0f))
 	float Points = 10.0f;
 
-	/** Amount of damage this enemy deals on overlap. */
+	/** Amount of damage this enemy deals on contact with a player. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Interaction", meta = (ClampMin = -1000.0f, ClampMax = 0.0f))
 	float Damage = -4.0f;
 
@@ -133,12 +148,6 @@ protected:
 	 */
 	virtual void Tick(float DeltaTime) override;
 
-	/**
-	 * Called when another actor begins to overlap with this enemy.
-	 * @param OtherActor The actor that started overlapping.
-	 */
-	virtual void NotifyActorBeginOverlap(AActor* OtherActor) override;
-
 	/**
 	 * Called when the enemy is removed from the world.
 	 * @param EndPlayReason The reason for removal.
@@ -172,6 +181,13 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Interaction")
 	void HandleHealthChanged(const float HealthResult, const float TotalHealth);
 
+	/**
+	 * Handles the damage that depleted the enemy's health, awarding points to the responsible player.
+	 * @param Instigator The controller responsible for the depleting damage.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void HandleHealthDepleted(AController* Instigator);
+
 private:
 	/** Delegate used internally for the disappear timer. */
 	const FTimerDelegate DissapearDelegate = FTimerDelegate::CreateUFunction(this, GET_FUNCTION_NAME_CHECKED(ABaseEnemy, Multicast_Spawn), FVector::ZeroVector, false);
@@ -92,6 +92,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Stats|Equipment")
 	const int GetAmmunition() const;
 
+	/**
+	 * Returns the currently equipped weapon.
+	 * @return The equipped weapon, or nullptr if none.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Equipment")
+	ABaseWeapon* GetCurrentWeapon() const;
+
+	/**
+	 * Returns the time in seconds the player has been alive, from its spawn time and the synchronized server time.
+	 * @return The survive time, or zero until the spawn time has been received.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+	const float GetSurviveTime() const;
+
 	/**
 	 * Adds ammunition to the player and broadcasts the update.
 	 * @param Amount The amount of ammunition to add.
@@ -132,10 +146,22 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Movement", meta = (ClampMin = 1.1f, ClampMax = 10.0f))
 	float SprintMultiplier = 1.6f;
 
-	/** Current amount of ammunition, replicated to clients. */
-	UPROPERTY(ReplicatedUsing = OnReplicateAmmunition, EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Equipment", meta = (ClampMin = 0, ClampMax = 10000))
+	/** Speed at which the weapon socket of other players follows their replicated aim pitch. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Movement", meta = (ClampMin = 0.0f, ClampMax = 100.0f))
+	float AimPitchInterpSpeed = 15.0f;
+
+	/** Current amount of ammunition, replicated to the owner through ReplicatedAmmunition. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Equipment", meta = (ClampMin = 0, ClampMax = 10000))
 	int Ammunition = 0;
 
+	/** Ammunition packed in 16 bits, pushed to the owner when it changes. */
+	UPROPERTY(ReplicatedUsing = OnReplicateAmmunition)
+	uint16 ReplicatedAmmunition = 0;
+
+	/** Server world time in seconds when the player spawned, replicated once to the owner. Negative until set. */
+	UPROPERTY(Replicated)
+	double SpawnServerTime = -1.0;
+
 	/** Collision object query parameters for interaction traces. */
 	FCollisionObjectQueryParams ObjectParams = FCollisionObjectQueryParams(ECC_WorldDynamic);
 
@@ -159,7 +185,7 @@ protected:
 
 	/**
 	 * Called every frame.
-	 * Handles movement input and draws debug lines for interaction.
+	 * Handles movement input, updates the aim pitch of the weapon socket and draws debug lines for interaction.
 	 * @param DeltaTime Time elapsed since the last tick.
 	 */
 	virtual void Tick(float DeltaTime) override;
@@ -206,11 +232,14 @@ protected:
 
 	/**
 	 * Called when the ammunition value is replicated.
-	 * Broadcasts the updated ammunition value.
+	 * Restores the ammunition from the replicated value and broadcasts it.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Stats|Equipment")
 	void OnReplicateAmmunition();
 
+	/** Packs the server ammunition into the replicated ammunition and marks it dirty for the push model. */
+	void UpdateReplicatedAmmunition();
+
 	/**
 	 * Handles changes in the player's health.
 	 * Destroys the player if health reaches zero.
@@ -255,9 +284,26 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Movement")
 	void HandleJump();
 
-	/** Handles the start of shooting input. Broadcasts the shoot held event. */
+	/**
+	 * Handles the shoot input being pressed.
+	 * Broadcasts the shoot held event locally so the owning client predicts its shots, then notifies the server.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void HandleShootPressed();
+
+	/**
+	 * Handles the shoot input being released.
+	 * Broadcasts the shoot held event locally to stop the predicted shots, then notifies the server.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void HandleShootReleased();
+
+	/**
+	 * Handles the start of shooting input. Broadcasts the shoot held event.
+	 * @param TriggerSequence The trigger sequence the press started on the owning client, adopted by the server weapon.
+	 */
 	UFUNCTION(Server, Reliable, BlueprintCallable, Category = "Interaction")
-	void HandleStartShoot();
+	void HandleStartShoot(const uint8 TriggerSequence);
 
 	/** Handles the stop of shooting input. Broadcasts the shoot held event. */
 	UFUNCTION(Server, Reliable, BlueprintCallable, Category = "Interaction")
@@ -281,16 +327,10 @@ protected:
 	void Server_DoorInteraction(ADoor* Door);
 
 	/**
-	 * Server-side implementation for updating the pitch view.
-	 * @param PitchInput The pitch value to update.
-	 */
-	UFUNCTION(Server, Reliable, BlueprintCallable, Category = "Movement")
-	void Server_UpdatePitchView(const float PitchInput);
-
-	/**
-	 * Multicast implementation for updating the pitch view on all clients.
-	 * @param PitchInput The pitch value to update.
+	 * Rotates the weapon socket to the aim pitch of the player.
+	 * The server and the owning client use the control rotation; other clients interpolate towards the replicated view pitch.
+	 * @param DeltaTime Time elapsed since the last update.
 	 */
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Movement")
-	void Multicast_UpdatePitchView(const float PitchInput);
+	UFUNCTION(BlueprintCallable, Category = "Movement")
+	void UpdateAimPitch(const float DeltaTime);
 };
@@ -9,6 +9,7 @@
  */
 
 #include "../Public/AttributesComponent.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 /**
  * Default constructor.
@@ -28,27 +29,32 @@ void UAttributesComponent::BeginPlay()
 	Super::BeginPlay();
 
 	CurrentHealth = MaxHealth;
+	UpdateReplicatedHealth();
 }
 
 /**
  * Registers properties for network replication.
+ * The health is push based and replicated to every client, which plays the death effects of enemies and barrels from it.
  * @param OutLifetimeProps The array to add replicated properties to.
  */
 void UAttributesComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UAttributesComponent, CurrentHealth);
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAttributesComponent, ReplicatedHealth, Params);
 }
 
 /**
  * Called when the component is removed from the world.
- * Clears the OnHealthChanged delegate to avoid dangling references.
+ * Clears the OnHealthChanged and OnHealthDepleted delegates to avoid dangling references.
  * @param EndPlayReason The reason for removal.
  */
 void UAttributesComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	OnHealthChanged.Clear();
+	OnHealthDepleted.Clear();
 }
 
 /**
@@ -83,25 +89,66 @@ bool UAttributesComponent::HealthReaction(const float Amount)
 	if (bSuccess)
 	{
 		CurrentHealth = Health;
+		UpdateReplicatedHealth();
 		OnHealthChanged.Broadcast(Health, MaxHealth);
 	}
 
 	return bSuccess;
 }
 
+/**
+ * Applies a health change caused by a controller.
+ * Broadcasts the OnHealthDepleted event if the change depletes the health.
+ * @param Amount The amount to change health by (negative for damage).
+ * @param Instigator The controller responsible for the change.
+ * @return True if the health value was changed, false otherwise.
+ */
+bool UAttributesComponent::ApplyDamage(const float Amount, AController* Instigator)
+{
+	const bool bSuccess = HealthReaction(Amount);
+	if (bSuccess && CurrentHealth <= 0.0f)
+	{
+		OnHealthDepleted.Broadcast(Instigator);
+	}
+
+	return bSuccess;
+}
+
 /**
  * Resets the current health to the maximum health value.
  */
 void UAttributesComponent::ResetHealth()
 {
 	CurrentHealth = MaxHealth;
+	UpdateReplicatedHealth();
+}
+
+/**
+ * Quantizes the current health into the replicated health and marks it dirty for the push model.
+ * On the server, a change forces a net update of the owner, so it is not delayed by a lowered net update frequency.
+ */
+void UAttributesComponent::UpdateReplicatedHealth()
+{
+	const uint16 Health = uint16(FMath::Clamp(FMath::CeilToInt(CurrentHealth / HealthQuantum), 0, int(MAX_uint16)));
+	if (Health != ReplicatedHealth)
+	{
+		ReplicatedHealth = Health;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UAttributesComponent, ReplicatedHealth, this);
+
+		AActor* Owner = GetOwner();
+		if (IsValid(Owner) && Owner->HasAuthority())
+		{
+			Owner->ForceNetUpdate();
+		}
+	}
 }
 
 /**
- * Called when the CurrentHealth property is replicated.
- * Broadcasts the OnHealthChanged event to update listeners.
+ * Called when the replicated health is received.
+ * Restores the current health from it and broadcasts the OnHealthChanged event to update listeners.
  */
 void UAttributesComponent::OnReplicateCurrentHealth()
 {
+	CurrentHealth = ReplicatedHealth * HealthQuantum;
 	OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 #include "AttributesComponent.generated.h"
 
+class AController;
+
 /**
  * Delegate broadcast when the health value changes.
  * @param HealthResult The new health value after the change.
@@ -13,6 +15,12 @@
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHealthChanged, const float, HealthResult, const float, TotalHealth);
 
+/**
+ * Delegate broadcast when applied damage depletes the health.
+ * @param Instigator The controller responsible for the depleting damage, if any.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHealthDepleted, AController*, Instigator);
+
 /**
  * UAttributesComponent
  *
@@ -30,6 +38,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnHealthChanged OnHealthChanged;
 
+	/** Event triggered when damage applied through ApplyDamage depletes the health. */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnHealthDepleted OnHealthDepleted;
+
 	/** Default constructor. Initializes default values and enables replication. */
 	UAttributesComponent();
 
@@ -56,6 +68,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Attributes")
 	bool HealthReaction(const float Amount);
 
+	/**
+	 * Applies a health change caused by a controller.
+	 * Broadcasts the OnHealthDepleted event if the change depletes the health.
+	 * @param Amount The amount to change health by (negative for damage).
+	 * @param Instigator The controller responsible for the change.
+	 * @return True if the health value was changed, false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Attributes")
+	bool ApplyDamage(const float Amount, AController* Instigator);
+
 	/**
 	 * Resets the current health to the maximum health value.
 	 */
@@ -67,10 +89,17 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes", meta = (ClampMin = 1.0f, ClampMax = 1000.0f))
 	float MaxHealth = 100.0f;
 
-	/** The current health value, replicated to clients. */
-	UPROPERTY(ReplicatedUsing = OnReplicateCurrentHealth, EditAnywhere, BlueprintReadWrite, Category = "Attributes", meta = (ClampMin = 1.0f, ClampMax = 1000.0f))
+	/** The current health value, replicated to clients through ReplicatedHealth. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attributes", meta = (ClampMin = 1.0f, ClampMax = 1000.0f))
 	float CurrentHealth = MaxHealth;
 
+	/** Precision of the replicated health, in health points per unit. */
+	static constexpr float HealthQuantum = 0.1f;
+
+	/** Current health quantized to 16 bits (rounded up, so a living actor never reads as depleted), pushed to clients on change. */
+	UPROPERTY(ReplicatedUsing = OnReplicateCurrentHealth)
+	uint16 ReplicatedHealth = 0;
+
 	/** Called when the game starts. Initializes health values. */
 	virtual void BeginPlay() override;
 
@@ -86,9 +115,12 @@ protected:
 	 */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Quantizes the current health into the replicated health and marks it dirty for the push model. */
+	void UpdateReplicatedHealth();
+
 	/**
-	 * Called when the CurrentHealth property is replicated.
-	 * Broadcasts the OnHealthChanged event.
+	 * Called when the replicated health is received.
+	 * Restores the current health from it and broadcasts the OnHealthChanged event.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Attributes")
 	void OnReplicateCurrentHealth();
@@ -0,0 +1,292 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file EnemyMovementProxy.cpp
+ * @brief Implements the logic for the AEnemyMovementProxy class, which replicates the movement of an enemy pool in one fast array.
+ *
+ * The server quantizes the position of every active enemy to 16 bits per axis relative to the arena bounds and its yaw
+ * to 8 bits, marking only the items that changed. Clients push every received movement into a short jitter buffer and
+ * render the enemies a fixed delay behind, interpolating between the samples bracketing that time.
+ */
+
+#include "../Public/EnemyMovementProxy.h"
+#include "../../Characters/Public/BaseEnemy.h"
+#include "../../Subsystems/Public/LagCompensationSubsystem.h"
+#include "../../QORPOTestJulian.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Movement Proxy"), STAT_EnemyMovementProxy, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Movement Items"), STAT_EnemyMovementItems, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Movement Bytes"), STAT_EnemyMovementBytes, STATGROUP_QORPOTestJulian);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Enemy Movement Bytes Per Enemy Per Second"), STAT_EnemyMovementBytesPerEnemyPerSecond, STATGROUP_QORPOTestJulian);
+
+/** Estimated size in bytes of a changed item: replication identifier, enemy reference, quantized position and yaw. */
+static constexpr int EstimatedItemBytes = 14;
+
+/** Maximum number of samples kept in the jitter buffer of every item. */
+static constexpr int MaxSamples = 4;
+
+/**
+ * Called on the client when the item is received for the first time. Starts the jitter buffer at the received movement.
+ * @param InArraySerializer The array holding the item.
+ */
+void FEnemyMovementItem::PostReplicatedAdd(const FEnemyMovementArray& InArraySerializer)
+{
+	Samples.Reset();
+	AddSample(IsValid(InArraySerializer.Owner) ? InArraySerializer.Owner->GetSampleTime() : 0.0f);
+}
+
+/**
+ * Called on the client when a new movement of the item is received. Appends it to the jitter buffer.
+ * @param InArraySerializer The array holding the item.
+ */
+void FEnemyMovementItem::PostReplicatedChange(const FEnemyMovementArray& InArraySerializer)
+{
+	AddSample(IsValid(InArraySerializer.Owner) ? InArraySerializer.Owner->GetSampleTime() : 0.0f);
+}
+
+/**
+ * Appends the received movement to the jitter buffer, dropping the oldest sample when it is full.
+ * @param Time The local world time when the movement was received.
+ */
+void FEnemyMovementItem::AddSample(const float Time)
+{
+	if (Samples.Num() >= MaxSamples)
+	{
+		Samples.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	FEnemyMovementSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.Time = Time;
+	Sample.Position = FVector(QuantizedX, QuantizedY, QuantizedZ) / float(MAX_uint16);
+	Sample.Yaw = QuantizedYaw * (360.0f / 256.0f);
+}
+
+/**
+ * Default constructor.
+ * Sets up replication and the owner of the movement array. The proxy is relevant to every connection and never moves.
+ */
+AEnemyMovementProxy::AEnemyMovementProxy()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bAlwaysRelevant = true;
+	SetReplicates(true);
+	SetReplicateMovement(false);
+	Movement.Owner = this;
+}
+
+/**
+ * Sets the arena bounds the positions are quantized against, grown by the arena margin.
+ * @param ArenaBounds The bounds every active enemy moves within.
+ */
+void AEnemyMovementProxy::SetArenaBounds(const FBox& ArenaBounds)
+{
+	const FBox Bounds = ArenaBounds.ExpandBy(ArenaMargin);
+	ArenaOrigin = Bounds.Min;
+	ArenaSize = Bounds.GetSize().ComponentMax(FVector(1.0f));
+	MARK_PROPERTY_DIRTY_FROM_NAME(AEnemyMovementProxy, ArenaOrigin, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AEnemyMovementProxy, ArenaSize, this);
+}
+
+/**
+ * Starts replicating the movement of an enemy through the proxy, turning off its own movement replication.
+ * @param Enemy The enemy to replicate.
+ */
+void AEnemyMovementProxy::RegisterEnemy(ABaseEnemy* Enemy)
+{
+	if (HasAuthority() && IsValid(Enemy) && !Enemies.Contains(Enemy))
+	{
+		Enemies.Add(Enemy);
+		Enemy->SetReplicateMovement(false);
+	}
+}
+
+/**
+ * Called when the game starts or when spawned.
+ * On the server, reports the interpolation delay to the lag compensation subsystem, since clients see and shoot the
+ * enemies that much further in the past.
+ */
+void AEnemyMovementProxy::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+	if (HasAuthority() && IsValid(LagCompensation))
+	{
+		LagCompensation->SetInterpolationDelay(InterpolationDelay);
+	}
+}
+
+/**
+ * Returns the local world time of the client, used to timestamp the received samples.
+ * @return The world time in seconds.
+ */
+const float AEnemyMovementProxy::GetSampleTime() const
+{
+	const UWorld* World = GetWorld();
+	return IsValid(World) ? World->GetTimeSeconds() : 0.0f;
+}
+
+/**
+ * Called every frame.
+ * Samples the registered enemies on the server, or interpolates them from their jitter buffers on clients.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void AEnemyMovementProxy::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemyMovementProxy);
+
+	HasAuthority() ? SampleEnemies() : InterpolateEnemies();
+}
+
+/**
+ * Called on the server before the proxy is replicated.
+ * Reports the estimated bytes of the items changed since the last replication, per active enemy and second.
+ * @param ChangedPropertyTracker The tracker of the properties changed since the last replication.
+ */
+void AEnemyMovementProxy::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	const float ElapsedTime = CurrentTime - LastReplicationTime;
+	LastReplicationTime = CurrentTime;
+	if (ChangedItems <= 0 || Movement.Items.IsEmpty() || ElapsedTime <= 0.0f)
+	{
+		ChangedItems = 0;
+
+		return;
+	}
+
+	const int Bytes = ChangedItems * EstimatedItemBytes;
+	INC_DWORD_STAT_BY(STAT_EnemyMovementItems, ChangedItems);
+	INC_DWORD_STAT_BY(STAT_EnemyMovementBytes, Bytes);
+	INC_FLOAT_STAT_BY(STAT_EnemyMovementBytesPerEnemyPerSecond, Bytes / (Movement.Items.Num() * ElapsedTime));
+	ChangedItems = 0;
+}
+
+/**
+ * Called when the game starts or when spawned.
+ * Samples the enemies at the update frequency on the server; clients interpolate every frame.
+ */
+void AEnemyMovementProxy::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (HasAuthority())
+	{
+		SetNetUpdateFrequency(UpdateFrequency);
+		SetActorTickInterval(1.0f / UpdateFrequency);
+	}
+}
+
+/**
+ * Registers properties for network replication.
+ * The arena bounds are push based, since they are only set once.
+ * @param OutLifetimeProps The array to add replicated properties to.
+ */
+void AEnemyMovementProxy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AEnemyMovementProxy, ArenaOrigin, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AEnemyMovementProxy, ArenaSize, Params);
+	DOREPLIFETIME(AEnemyMovementProxy, Movement);
+}
+
+/**
+ * Quantizes the movement of every active registered enemy, adding, updating and removing items as needed.
+ * Hidden (pooled-off) enemies are removed from the array, so the array only ever holds the enemies of the round.
+ */
+void AEnemyMovementProxy::SampleEnemies()
+{
+	bool bRemoved = false;
+	for (int i = Movement.Items.Num() - 1; i >= 0; i--)
+	{
+		const ABaseEnemy* Enemy = Movement.Items[i].Enemy;
+		if (!IsValid(Enemy) || Enemy->IsHidden())
+		{
+			Movement.Items.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			bRemoved = true;
+		}
+	}
+
+	if (bRemoved)
+	{
+		ItemIndices.Reset();
+		for (int i = 0; i < Movement.Items.Num(); i++)
+		{
+			ItemIndices.Add(Movement.Items[i].Enemy, i);
+		}
+
+		Movement.MarkArrayDirty();
+	}
+
+	for (const TWeakObjectPtr<ABaseEnemy>& WeakEnemy : Enemies)
+	{
+		ABaseEnemy* Enemy = WeakEnemy.Get();
+		if (!IsValid(Enemy) || Enemy->IsHidden())
+		{
+			continue;
+		}
+
+		const FVector Normalized = ((Enemy->GetActorLocation() - ArenaOrigin) / ArenaSize).BoundToBox(FVector::ZeroVector, FVector::OneVector);
+		const uint16 QuantizedX = uint16(FMath::RoundToInt(Normalized.X * MAX_uint16));
+		const uint16 QuantizedY = uint16(FMath::RoundToInt(Normalized.Y * MAX_uint16));
+		const uint16 QuantizedZ = uint16(FMath::RoundToInt(Normalized.Z * MAX_uint16));
+		const uint8 QuantizedYaw = uint8(FMath::RoundToInt(FRotator::ClampAxis(Enemy->GetActorRotation().Yaw) * (256.0f / 360.0f)) & MAX_uint8);
+
+		const int* Index = ItemIndices.Find(Enemy);
+		FEnemyMovementItem& Item = Index != nullptr ? Movement.Items[*Index] : Movement.Items.AddDefaulted_GetRef();
+		if (Index == nullptr)
+		{
+			Item.Enemy = Enemy;
+			ItemIndices.Add(Enemy, Movement.Items.Num() - 1);
+		}
+		else if (Item.QuantizedX == QuantizedX && Item.QuantizedY == QuantizedY && Item.QuantizedZ == QuantizedZ && Item.QuantizedYaw == QuantizedYaw)
+		{
+			continue;
+		}
+
+		Item.QuantizedX = QuantizedX;
+		Item.QuantizedY = QuantizedY;
+		Item.QuantizedZ = QuantizedZ;
+		Item.QuantizedYaw = QuantizedYaw;
+		Movement.MarkItemDirty(Item);
+		ChangedItems++;
+	}
+}
+
+/**
+ * Moves every enemy of the array to its interpolated movement.
+ * Enemies are rendered InterpolationDelay behind the current time, between the two samples bracketing that time;
+ * without a newer sample the last one is held rather than extrapolated.
+ */
+void AEnemyMovementProxy::InterpolateEnemies()
+{
+	const float RenderTime = GetSampleTime() - InterpolationDelay;
+	for (FEnemyMovementItem& Item : Movement.Items)
+	{
+		if (!IsValid(Item.Enemy) || Item.Samples.IsEmpty())
+		{
+			continue;
+		}
+
+		while (Item.Samples.Num() > 2 && Item.Samples[1].Time <= RenderTime)
+		{
+			Item.Samples.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+
+		const FEnemyMovementSample& From = Item.Samples[0];
+		const FEnemyMovementSample& To = Item.Samples[FMath::Min(1, Item.Samples.Num() - 1)];
+		const float Alpha = To.Time > From.Time ? FMath::Clamp((RenderTime - From.Time) / (To.Time - From.Time), 0.0f, 1.0f) : 1.0f;
+		const FVector Position = ArenaOrigin + FMath::Lerp(From.Position, To.Position, Alpha) * ArenaSize;
+		const float Yaw = From.Yaw + FMath::FindDeltaAngleDegrees(From.Yaw, To.Yaw) * Alpha;
+		const FRotator& Rotation = Item.Enemy->GetActorRotation();
+		Item.Enemy->SetActorLocationAndRotation(Position, FRotator(Rotation.Pitch, Yaw, Rotation.Roll));
+	}
+}
\ No newline at end of file
@@ -13,17 +13,19 @@
 
 /**
  * Default constructor.
- * Sets the default player controller and pawn classes for the game mode.
+ * Sets the default player controller, pawn and game state classes for the game mode.
  */
 AShooterGameModeBase::AShooterGameModeBase()
 {
 	PlayerControllerClass = AShooterPlayerController::StaticClass();
 	DefaultPawnClass = AShooterPlayer::StaticClass();
+	GameStateClass = AShooterGameState::StaticClass();
 }
 
 /**
  * Called when the game starts or when spawned.
- * Initializes navigation mesh bounds, spawns all enemies for each class, and sets up the timer for the first round.
+ * Initializes navigation mesh bounds, spawns all enemies for each class, starts the match clock, and sets up the timer
+ * for the first round.
  */
 void AShooterGameModeBase::BeginPlay()
 {
@@ -45,6 +47,13 @@ void AShooterGameModeBase::BeginPlay()
         SpawnAllEnemies(K);
     }
 
+    // Start the match clock replicated to every player
+    AShooterGameState* ShooterGameState = GetGameState<AShooterGameState>();
+    if (IsValid(ShooterGameState))
+    {
+        ShooterGameState->StartMatchClock();
+    }
+
     // Set timer to start the first round after a delay
     GetWorldTimerManager().SetTimer(BetweenRoundsTimerHandle, BetweenRoundsTimerDelegate, BetweenRoundsTime, false);
 }
@@ -66,6 +75,8 @@ void AShooterGameModeBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 /**
  * Spawns all enemies of the specified class for the current round.
  * Each spawned enemy is hidden at EnemyHiddenPosition and bound to the HandleEnemyOut event.
+ * If EnemyMovementProxyClass is set, a movement proxy bounded by the navigation mesh bounds is spawned for the pool
+ * and every enemy is registered in it.
  *
  * @param EnemyClass The class of enemy to spawn.
  */
@@ -78,17 +89,45 @@ void AShooterGameModeBase::SpawnAllEnemies(TSubclassOf<ABaseEnemy> EnemyClass)
     }
 
     FRoundSpawnable& SpawnableParameters = RoundSpawnableParameters[EnemyClass];
+    if (IsValid(EnemyMovementProxyClass) && !IsValid(SpawnableParameters.MovementProxy))
+    {
+        FBox ArenaBounds = FBox(ForceInit);
+        for (const ANavMeshBoundsVolume* BoundsVolume : NavMeshBoundsContainer)
+        {
+            if (IsValid(BoundsVolume))
+            {
+                ArenaBounds += BoundsVolume->GetComponentsBoundingBox(true);
+            }
+        }
+
+        if (ArenaBounds.IsValid && SpawnableParameters.SpawnAltitude >= 0.0f)
+        {
+            ArenaBounds += FVector(ArenaBounds.Min.X, ArenaBounds.Min.Y, SpawnableParameters.SpawnAltitude);
+        }
+
+        SpawnableParameters.MovementProxy = World->SpawnActor<AEnemyMovementProxy>(EnemyMovementProxyClass);
+        if (IsValid(SpawnableParameters.MovementProxy))
+        {
+            SpawnableParameters.MovementProxy->SetArenaBounds(ArenaBounds.IsValid ? ArenaBounds : FBox(FVector(-10000.0f), FVector(10000.0f)));
+        }
+    }
+
     for (unsigned short i = 0; i < SpawnableParameters.TotalEnemies; i++)
     {
         ABaseEnemy* Enemy = World->SpawnActor<ABaseEnemy>(EnemyClass, EnemyHiddenPosition, FRotator::ZeroRotator);
         SpawnableParameters.EnemiesContainer.AddUnique(Enemy);
         Enemy->OnEnemyOut.AddUniqueDynamic(this, &AShooterGameModeBase::HandleEnemyOut);
+        if (IsValid(SpawnableParameters.MovementProxy))
+        {
+            SpawnableParameters.MovementProxy->RegisterEnemy(Enemy);
+        }
     }
 }
 
 /**
  * Activates a subset of enemies of the specified class for the current round.
- * Randomly selects enemies and spawn locations within navigation mesh bounds, and calls their Multicast_Spawn method.
+ * Randomly selects enemies and spawn locations within navigation mesh bounds, and calls their Multicast_Spawn method
+ * once they are woken on the network, since pooled enemies are dormant and would never receive it.
  * Increases the EnemiesAmountMultiplier for the next round.
  *
  * @param EnemyClass The class of enemy to activate.
@@ -124,6 +163,7 @@ void AShooterGameModeBase::ActivateRoundEnemies(TSubclassOf<ABaseEnemy> EnemyCla
             DesiredPosition.Z = SpawnableParameters.SpawnAltitude;
         }
 
+        Enemy->WakePooledActor();
         Enemy->Multicast_Spawn(DesiredPosition);
         RoundEnemies.AddUnique(Enemy);
     }
@@ -154,7 +194,8 @@ void AShooterGameModeBase::HandleEnemyOut(ABaseEnemy* OutEnemy)
 
 /**
  * Handles the transition to the next round.
- * Activates enemies for all enemy classes, increments the round counter, and broadcasts the OnRoundStarted event.
+ * Activates enemies for all enemy classes, increments the round counter, publishes it in the game state,
+ * and broadcasts the OnRoundStarted event.
  * Can be overridden in Blueprints for custom round progression logic.
  */
 void AShooterGameModeBase::HandleNextRound_Implementation()
@@ -170,5 +211,11 @@ void AShooterGameModeBase::HandleNextRound_Implementation()
     }
 
     CurrentRound = FMath::Clamp(CurrentRound + 1, 0, INT_MAX);
+    AShooterGameState* ShooterGameState = GetGameState<AShooterGameState>();
+    if (IsValid(ShooterGameState))
+    {
+        ShooterGameState->SetCurrentRound(CurrentRound);
+    }
+
     OnRoundStarted.Broadcast(CurrentRound);
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file ShooterGameState.cpp
+ * @brief Implements the logic for the AShooterGameState class, which replicates the match clock and the current round.
+ *
+ * This class replaces the per-controller survive time and round updates: the match start time and the round are
+ * replicated once for every player, and the elapsed match time is derived locally from the synchronized server time.
+ */
+
+#include "../Public/ShooterGameState.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+/**
+ * Starts the match clock at the current server time. Only called on the server.
+ */
+void AShooterGameState::StartMatchClock()
+{
+	if (HasAuthority())
+	{
+		MatchStartTime = GetServerWorldTimeSeconds();
+		MARK_PROPERTY_DIRTY_FROM_NAME(AShooterGameState, MatchStartTime, this);
+	}
+}
+
+/**
+ * Sets the current round and broadcasts the OnRoundUpdated event. Only called on the server.
+ * @param Round The new round number.
+ */
+void AShooterGameState::SetCurrentRound(const int Round)
+{
+	if (!HasAuthority() || Round == CurrentRound)
+	{
+		return;
+	}
+
+	CurrentRound = Round;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AShooterGameState, CurrentRound, this);
+	OnRoundUpdated.Broadcast(CurrentRound);
+}
+
+/**
+ * Returns the current round.
+ * @return The current round number.
+ */
+const int AShooterGameState::GetCurrentRound() const
+{
+	return CurrentRound;
+}
+
+/**
+ * Returns whether the match clock has started.
+ * @return True once the server started the clock and its start time has been received.
+ */
+const bool AShooterGameState::HasMatchStarted() const
+{
+	return MatchStartTime >= 0.0;
+}
+
+/**
+ * Returns the time elapsed since the match started, derived from the synchronized server world time.
+ * @return The match time in seconds, or zero before the match starts.
+ */
+const float AShooterGameState::GetMatchTime() const
+{
+	return HasMatchStarted() ? float(FMath::Max(GetServerWorldTimeSeconds() - MatchStartTime, 0.0)) : 0.0f;
+}
+
+/**
+ * Registers properties for network replication.
+ * The match start time and the round are push based, marked dirty only when they change.
+ * @param OutLifetimeProps The array to add replicated properties to.
+ */
+void AShooterGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AShooterGameState, MatchStartTime, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AShooterGameState, CurrentRound, Params);
+}
+
+/**
+ * Called when the CurrentRound property is replicated.
+ * Broadcasts the OnRoundUpdated event.
+ */
+void AShooterGameState::OnReplicateCurrentRound()
+{
+	OnRoundUpdated.Broadcast(CurrentRound);
+}
\ No newline at end of file
@@ -5,13 +5,16 @@
  * @brief Implements the logic for the AShooterPlayerController class, which manages player input, UI, score, and survive time.
  *
  * This class handles player-specific logic such as UI widget creation, score and survive time tracking, event binding,
- * and networked updates for health, ammunition, and round information. It is designed to be extended and supports
- * both C++ and Blueprint customization.
+ * and networked updates for health, ammunition, and round information. The HUD values are replicated to the owning
+ * client in one compact owner-only state instead of per-value RPCs, the round is read from the game state, and the
+ * survive time is derived from the spawn time of the possessed player instead of being replicated every second.
+ * It is designed to be extended and supports both C++ and Blueprint customization.
  */
 
 #include "../Public/ShooterPlayerController.h"
-#include "../Public/ShooterGameModeBase.h"
 #include "../../Characters/Public/ShooterPlayer.h"
+#include "../../Weapons/Public/BaseWeapon.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 /**
  * Default constructor.
@@ -26,48 +29,39 @@ AShooterPlayerController::AShooterPlayerController()
 
 /**
  * Called when the game starts or when spawned.
- * Initializes the player UI widget and binds to round events.
+ * Initializes the player UI widget and, on the local controller, starts updating the survive time at a fixed interval.
  */
 void AShooterPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
 	CreatePlayerWidget();
-	UWorld* World = GetWorld();
-	AShooterGameModeBase* GameMode = IsValid(World) ? World->GetAuthGameMode<AShooterGameModeBase>() : nullptr;
-	if (IsValid(GameMode))
+	if (IsLocalController())
 	{
-		GameMode->OnRoundStarted.AddUniqueDynamic(this, &AShooterPlayerController::Multicast_HandleRoundUpdated);
+		GetWorldTimerManager().SetTimer(SurviveTimeTimerHandle, this, &AShooterPlayerController::UpdateSurviveTime, SurviveTimeUpdateInterval, true);
+		UpdateSurviveTime();
 	}
 }
 
 /**
  * Registers properties for network replication.
+ * The score and HUD state are push based, marked dirty only when they change, and only replicated to the owner.
  * @param OutLifetimeProps The array to add replicated properties to.
  */
 void AShooterPlayerController::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AShooterPlayerController, SurviveTime);
-	DOREPLIFETIME(AShooterPlayerController, CurrentScore);
-}
-
-/**
- * Called every frame.
- * Updates the survive time for the player.
- * @param DeltaTime Time elapsed since the last tick.
- */
-void AShooterPlayerController::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	UpdateSurviveTime();
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	Params.Condition = COND_OwnerOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AShooterPlayerController, CurrentScore, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AShooterPlayerController, HudState, Params);
 }
 
 /**
  * Called when this controller possesses a new pawn.
- * Binds to health and ammunition events from the possessed player.
+ * Binds to health, ammunition and magazine events from the possessed player and fills the HUD state with its values.
  * @param InPawn The pawn being possessed.
  */
 void AShooterPlayerController::OnPossess(APawn* InPawn)
@@ -79,24 +73,48 @@ void AShooterPlayerController::OnPossess(APawn* InPawn)
 	{
 		return;
 	}
-	else if (IsValid(ShooterPlayer->GetAttributesComponent()))
+
+	UAttributesComponent* Attributes = ShooterPlayer->GetAttributesComponent();
+	if (IsValid(Attributes))
 	{
-		ShooterPlayer->GetAttributesComponent()->OnHealthChanged.AddUniqueDynamic(this, &AShooterPlayerController::Multicast_HandleHealthUpdated);
+		Attributes->OnHealthChanged.AddUniqueDynamic(this, &AShooterPlayerController::HandleHealthUpdated);
+		HandleHealthUpdated(Attributes->GetHealth(), Attributes->GetMaxHealth());
 	}
 
-	ShooterPlayer->OnPlayerAmmunitionUpdated.AddUniqueDynamic(this, &AShooterPlayerController::Multicast_HandlePlayerAmmunitionUpdated);
-	ShooterPlayer->OnWeaponMagazineUpdated.AddUniqueDynamic(this, &AShooterPlayerController::Multicast_HandleWeaponMagazineUpdated);
+	ShooterPlayer->OnPlayerAmmunitionUpdated.AddUniqueDynamic(this, &AShooterPlayerController::HandlePlayerAmmunitionUpdated);
+	ShooterPlayer->OnWeaponMagazineUpdated.AddUniqueDynamic(this, &AShooterPlayerController::HandleWeaponMagazineUpdated);
+	HandlePlayerAmmunitionUpdated(ShooterPlayer->GetAmmunition());
+
+	const ABaseWeapon* Weapon = ShooterPlayer->GetCurrentWeapon();
+	HandleWeaponMagazineUpdated(IsValid(Weapon) ? Weapon->GetMagazine() : 0);
+}
+
+/**
+ * Called on the owning client when the possession of a pawn is acknowledged.
+ * Binds to the magazine events of the local player so predicted shots update the UI right away.
+ * @param InPawn The possessed pawn.
+ */
+void AShooterPlayerController::AcknowledgePossession(APawn* InPawn)
+{
+	Super::AcknowledgePossession(InPawn);
+
+	AShooterPlayer* ShooterPlayer = Cast<AShooterPlayer>(InPawn);
+	if (IsValid(ShooterPlayer))
+	{
+		ShooterPlayer->OnWeaponMagazineUpdated.AddUniqueDynamic(this, &AShooterPlayerController::HandleWeaponMagazineUpdated);
+	}
 }
 
 /**
  * Called when the controller is removed from the world.
- * Clears all event bindings.
+ * Clears all event bindings and the survive time timer.
  * @param EndPlayReason The reason for removal.
  */
 void AShooterPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	GetWorldTimerManager().ClearTimer(SurviveTimeTimerHandle);
 	OnSurviveTimeUpdated.Clear();
 	OnScoreUpdated.Clear();
 }
@@ -121,48 +139,69 @@ void AShooterPlayerController::UpdateScore(const float Points)
 	CurrentScore = FMath::Clamp(Score + Points, 0.0f, float(INT_MAX));
 	if (CurrentScore != Score)
 	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AShooterPlayerController, CurrentScore, this);
 		OnScoreUpdated.Broadcast(CurrentScore);
 	}
 }
 
 /**
- * Server-side function to apply damage to a target actor.
+ * Applies damage dealt by one of the player's actors.
+ * Damage is only dealt by the server; calls on clients are ignored.
  * @param DamageReceiver The actor receiving damage.
  * @param DamageAmount The amount of damage to apply.
  * @param DamageEvent The damage event struct.
- * @param EventInstigator The controller responsible for the damage.
  * @param DamageCauser The actor causing the damage.
  */
-void AShooterPlayerController::Server_DoDamage_Implementation(AActor* DamageReceiver, float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+void AShooterPlayerController::DoDamage(AActor* DamageReceiver, const float DamageAmount, FDamageEvent const& DamageEvent, AActor* DamageCauser)
 {
-	if (IsValid(DamageReceiver))
+	if (HasAuthority() && IsValid(DamageReceiver))
 	{
-		DamageReceiver->TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+		DamageReceiver->TakeDamage(DamageAmount, DamageEvent, this, DamageCauser);
 	}
 }
 
 /**
- * Updates the survive time for the player and broadcasts the event if it changes.
+ * Updates the survive time for the player from the lifetime of its pawn and broadcasts the event when it reaches a new whole second.
+ * The lifetime is derived from the spawn time replicated once with the pawn and the synchronized server time, so a late
+ * joiner only counts its own time. The survive time freezes once the pawn is destroyed on death.
  */
 void AShooterPlayerController::UpdateSurviveTime()
 {
-	APawn* CurrentPawn = GetPawn();
-	if (!IsValid(CurrentPawn))
+	BindShooterGameState();
+	const AShooterPlayer* ShooterPlayer = GetPawn<AShooterPlayer>();
+	if (!IsValid(ShooterPlayer))
 	{
 		return;
 	}
 
-	const float CurrentTime = CurrentPawn->GetGameTimeSinceCreation();
-	if (!FMath::IsNearlyEqual(CurrentTime, SurviveTime, 1.0f))
+	const float CurrentTime = ShooterPlayer->GetSurviveTime();
+	if (FMath::FloorToInt(CurrentTime) != FMath::FloorToInt(SurviveTime))
 	{
 		SurviveTime = CurrentTime;
 		OnSurviveTimeUpdated.Broadcast(CurrentTime);
 	}
 }
 
+/**
+ * Returns the game state, binding to its round events the first time it is available on this machine.
+ * The game state can reach a client after its controller begins play, so the binding is retried on every update.
+ * @return The shooter game state, or null if it has not been received yet.
+ */
+AShooterGameState* AShooterPlayerController::BindShooterGameState()
+{
+	AShooterGameState* ShooterGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (IsValid(ShooterGameState) && !ShooterGameState->OnRoundUpdated.IsAlreadyBound(this, &AShooterPlayerController::HandleRoundUpdated))
+	{
+		ShooterGameState->OnRoundUpdated.AddUniqueDynamic(this, &AShooterPlayerController::HandleRoundUpdated);
+		HandleRoundUpdated(ShooterGameState->GetCurrentRound());
+	}
+
+	return ShooterGameState;
+}
+
 /**
  * Creates and initializes the player's UI widget.
- * Binds UI events and updates initial ammunition display.
+ * Binds UI events and displays the HUD state received so far.
  */
 void AShooterPlayerController::CreatePlayerWidget()
 {
@@ -187,38 +226,57 @@ void AShooterPlayerController::CreatePlayerWidget()
 	OnSurviveTimeUpdated.AddUniqueDynamic(PlayerWidget, &UPlayerWidget::HandleSurviveTimeTextUpdated);
 	OnScoreUpdated.AddUniqueDynamic(PlayerWidget, &UPlayerWidget::HandleScoreTextUpdated);
 
-	AShooterPlayer* ShooterPlayer = GetPawn<AShooterPlayer>();
-	if (IsValid(ShooterPlayer))
-	{
-		Multicast_HandlePlayerAmmunitionUpdated(ShooterPlayer->GetAmmunition());
-	}
+	RefreshPlayerWidget();
 }
 
 /**
- * Called when the SurviveTime property is replicated.
- * Broadcasts the OnSurviveTimeUpdated event.
+ * Called when the CurrentScore property is replicated.
+ * Broadcasts the OnScoreUpdated event.
  */
-void AShooterPlayerController::OnReplicateSurviveTime()
+void AShooterPlayerController::OnReplicatedCurrentScore()
 {
-	OnSurviveTimeUpdated.Broadcast(SurviveTime);
+	OnScoreUpdated.Broadcast(CurrentScore);
 }
 
 /**
- * Called when the CurrentScore property is replicated.
- * Broadcasts the OnScoreUpdated event.
+ * Called when the HudState property is replicated.
+ * Updates every value of the UI from it; replication only sends the members that changed.
  */
-void AShooterPlayerController::OnReplicatedCurrentScore()
+void AShooterPlayerController::OnReplicateHudState()
 {
-	OnScoreUpdated.Broadcast(CurrentScore);
+	RefreshPlayerWidget();
+}
+
+/**
+ * Updates the health, ammunition and magazine of the UI from the HUD state.
+ * A weapon predicting its shots shows its predicted magazine instead of the older server value.
+ */
+void AShooterPlayerController::RefreshPlayerWidget()
+{
+	if (!IsValid(PlayerWidget))
+	{
+		return;
+	}
+
+	const AShooterPlayer* ShooterPlayer = GetPawn<AShooterPlayer>();
+	const ABaseWeapon* Weapon = IsValid(ShooterPlayer) ? ShooterPlayer->GetCurrentWeapon() : nullptr;
+	PlayerWidget->HandleHealthProgressBarUpdated(HudState.GetHealth(), HudState.GetMaxHealth());
+	PlayerWidget->HandlePlayerAmmunitionTextUpdated(HudState.Ammunition);
+	PlayerWidget->HandleWeaponMagazineTextUpdated(IsValid(Weapon) && Weapon->IsPredictingFire() ? Weapon->GetMagazine() : HudState.Magazine);
 }
 
 /**
- * Multicast function to update the player's health in the UI on all clients.
+ * Updates the player's health in the HUD state on the server and in the UI.
  * @param CurrentHealth The current health value.
  * @param MaxHealth The maximum health value.
  */
-void AShooterPlayerController::Multicast_HandleHealthUpdated_Implementation(const float CurrentHealth, const float MaxHealth)
+void AShooterPlayerController::HandleHealthUpdated(const float CurrentHealth, const float MaxHealth)
 {
+	if (HasAuthority() && HudState.SetHealth(CurrentHealth, MaxHealth))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AShooterPlayerController, HudState, this);
+	}
+
 	if (IsValid(PlayerWidget))
 	{
 		PlayerWidget->HandleHealthProgressBarUpdated(CurrentHealth, MaxHealth);
@@ -226,10 +284,10 @@ void AShooterPlayerController::Multicast_HandleHealthUpdated_Implementation(cons
 }
 
 /**
- * Multicast function to update the current round in the UI on all clients.
+ * Updates the current round in the UI.
  * @param CurrentRound The current round number.
  */
-void AShooterPlayerController::Multicast_HandleRoundUpdated_Implementation(const int CurrentRound)
+void AShooterPlayerController::HandleRoundUpdated(const int CurrentRound)
 {
 	if (IsValid(PlayerWidget))
 	{
@@ -238,23 +296,36 @@ void AShooterPlayerController::Multicast_HandleRoundUpdated_Implementation(const
 }
 
 /**
- * Multicast function to update the weapon's magazine in the UI on all clients.
+ * Updates the weapon's magazine in the HUD state on the server and in the UI.
+ * A weapon predicting its shots shows its predicted magazine instead of the older server value.
  * @param Magazine The current magazine value.
  */
-void AShooterPlayerController::Multicast_HandleWeaponMagazineUpdated_Implementation(const int Magazine)
+void AShooterPlayerController::HandleWeaponMagazineUpdated(const int Magazine)
 {
+	if (HasAuthority() && HudState.SetMagazine(Magazine))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AShooterPlayerController, HudState, this);
+	}
+
+	const AShooterPlayer* ShooterPlayer = GetPawn<AShooterPlayer>();
+	const ABaseWeapon* Weapon = IsValid(ShooterPlayer) ? ShooterPlayer->GetCurrentWeapon() : nullptr;
 	if (IsValid(PlayerWidget))
 	{
-		PlayerWidget->HandleWeaponMagazineTextUpdated(Magazine);
+		PlayerWidget->HandleWeaponMagazineTextUpdated(IsValid(Weapon) && Weapon->IsPredictingFire() ? Weapon->GetMagazine() : Magazine);
 	}
 }
 
 /**
- * Multicast function to update the player's ammunition in the UI on all clients.
+ * Updates the player's ammunition in the HUD state on the server and in the UI.
  * @param CurrentAmmunition The current ammunition value.
  */
-void AShooterPlayerController::Multicast_HandlePlayerAmmunitionUpdated_Implementation(const int CurrentAmmunition)
+void AShooterPlayerController::HandlePlayerAmmunitionUpdated(const int CurrentAmmunition)
 {
+	if (HasAuthority() && HudState.SetAmmunition(CurrentAmmunition))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AShooterPlayerController, HudState, this);
+	}
+
 	if (IsValid(PlayerWidget))
 	{
 		PlayerWidget->HandlePlayerAmmunitionTextUpdated(CurrentAmmunition);
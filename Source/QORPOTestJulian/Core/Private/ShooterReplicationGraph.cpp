@@ -0,0 +1,182 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file ShooterReplicationGraph.cpp
+ * @brief Implements the logic for the UShooterReplicationGraph class, which gathers the replicated actors of every connection.
+ *
+ * Actors are routed once, when they start replicating: always relevant actors to a shared list, owner-only actors to the
+ * per-connection nodes and everything else to a 2D spatialization grid, with reusable actors added through the dormancy
+ * aware path so dormant pooled actors are neither gathered nor considered for replication.
+ */
+
+#include "../Public/ShooterReplicationGraph.h"
+#include "../../QORPOTestJulian.h"
+#include "../../Characters/Public/ShooterPlayer.h"
+#include "../../Interfaces/Public/ReusableInterface.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Engine/NetConnection.h"
+
+DECLARE_CYCLE_STAT(TEXT("Replication Graph Server Replicate"), STAT_ReplicationGraphServerReplicate, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Replication Connections"), STAT_ReplicationConnections, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Replicated Actors"), STAT_ReplicatedActors, STATGROUP_QORPOTestJulian);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Replication Time Per Connection (ms)"), STAT_ReplicationTimePerConnection, STATGROUP_QORPOTestJulian);
+
+/**
+ * Sets the replication period and cull distance of every replicated actor class from its defaults.
+ * Blueprint skeleton and reinstanced classes are skipped, since no actor of theirs ever replicates.
+ */
+void UShooterReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject(false));
+		if (!IsValid(ActorCDO) || !ActorCDO->GetIsReplicated() || Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		FClassReplicationInfo ClassInfo = FClassReplicationInfo();
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(FMath::Max(ActorCDO->GetNetUpdateFrequency(), 1.0f));
+		if (!IsAlwaysRelevant(ActorCDO) && !ActorCDO->bOnlyRelevantToOwner)
+		{
+			ClassInfo.SetCullDistanceSquared(ActorCDO->GetNetCullDistanceSquared());
+		}
+
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+/**
+ * Creates the spatialization grid and the always relevant node shared by every connection.
+ */
+void UShooterReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = GridSpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+/**
+ * Creates the always relevant node of a connection, gathering its controller, pawn and view target.
+ * @param RepGraphConnection The connection being initialized.
+ */
+void UShooterReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	AddConnectionGraphNode(CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>(), RepGraphConnection);
+}
+
+/**
+ * Routes a new replicated actor to the always relevant node or the spatialization grid.
+ * Owner-only actors are not routed, since the per-connection node gathers them for their owner.
+ * @param ActorInfo The actor being added.
+ * @param GlobalInfo The global replication info of the actor.
+ */
+void UShooterReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	const AActor* Actor = ActorInfo.GetActor();
+	if (IsAlwaysRelevant(Actor))
+	{
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+	}
+	else if (Actor->bOnlyRelevantToOwner)
+	{
+		return;
+	}
+	else if (IsReusable(Actor))
+	{
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+	}
+	else
+	{
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+	}
+}
+
+/**
+ * Removes a replicated actor from the node it was routed to.
+ * @param ActorInfo The actor being removed.
+ */
+void UShooterReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	const AActor* Actor = ActorInfo.GetActor();
+	if (IsAlwaysRelevant(Actor))
+	{
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+	else if (Actor->bOnlyRelevantToOwner)
+	{
+		return;
+	}
+	else if (IsReusable(Actor))
+	{
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+	}
+	else
+	{
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+	}
+}
+
+/**
+ * Replicates the actors of every connection, reporting the server replication time per connection.
+ * @param DeltaSeconds Time elapsed since the last replication.
+ * @return The number of actors replicated.
+ */
+int32 UShooterReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ReplicationGraphServerReplicate);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 ReplicatedActors = Super::ServerReplicateActors(DeltaSeconds);
+	const int ConnectionCount = Connections.Num();
+	SET_DWORD_STAT(STAT_ReplicationConnections, ConnectionCount);
+	SET_DWORD_STAT(STAT_ReplicatedActors, ReplicatedActors);
+	SET_FLOAT_STAT(STAT_ReplicationTimePerConnection, ConnectionCount > 0 ? float((FPlatformTime::Seconds() - StartTime) * 1000.0 / ConnectionCount) : 0.0f);
+
+	return ReplicatedActors;
+}
+
+/**
+ * Overrides the replication period of an actor, which otherwise follows the settings of its class.
+ * Actors not yet known by the graph are ignored.
+ * @param Actor The actor to update.
+ * @param Frequency The new replication frequency.
+ */
+void UShooterReplicationGraph::SetActorReplicationFrequency(AActor* Actor, const float Frequency)
+{
+	FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor);
+	if (GlobalInfo != nullptr)
+	{
+		GlobalInfo->Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(FMath::Max(Frequency, 1.0f));
+	}
+}
+
+/**
+ * Returns whether an actor is replicated to every connection regardless of its position.
+ * @param Actor The actor to check.
+ * @return True for players, the game state, player states and actors flagged always relevant.
+ */
+const bool UShooterReplicationGraph::IsAlwaysRelevant(const AActor* Actor) const
+{
+	return Actor->bAlwaysRelevant || Actor->IsA<AShooterPlayer>() || Actor->IsA<AGameStateBase>() || Actor->IsA<APlayerState>();
+}
+
+/**
+ * Returns whether an actor is pooled and spatialized through the dormancy aware path.
+ * @param Actor The actor to check.
+ * @return True for actors implementing the reusable interface.
+ */
+const bool UShooterReplicationGraph::IsReusable(const AActor* Actor) const
+{
+	return Actor->GetClass()->ImplementsInterface(UReusableInterface::StaticClass());
+}
\ No newline at end of file
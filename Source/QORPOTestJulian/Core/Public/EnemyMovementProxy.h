@@ -0,0 +1,244 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "Net/UnrealNetwork.h"
+
+#include "EnemyMovementProxy.generated.h"
+
+class ABaseEnemy;
+class AEnemyMovementProxy;
+struct FEnemyMovementArray;
+
+/**
+ * FEnemyMovementSample
+ *
+ * Movement of an enemy received by a client, kept in the jitter buffer of its item until it is interpolated past.
+ */
+struct FEnemyMovementSample
+{
+	/** Local world time when the sample was received. */
+	float Time = 0.0f;
+
+	/** Position of the enemy, normalized from 0 to 1 along every axis of the arena bounds. */
+	FVector Position = FVector::ZeroVector;
+
+	/** Yaw of the enemy in degrees. */
+	float Yaw = 0.0f;
+};
+
+/**
+ * FEnemyMovementItem
+ *
+ * Movement of a single active enemy in the movement array: its position quantized to 16 bits per axis relative to the
+ * arena bounds and its yaw quantized to 8 bits. Clients keep the last received samples to interpolate from.
+ */
+USTRUCT()
+struct FEnemyMovementItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor. Initializes default values for the item. */
+	FEnemyMovementItem() {}
+
+	/** Enemy moved by the item. */
+	UPROPERTY()
+	ABaseEnemy* Enemy = nullptr;
+
+	/** Quantized X position relative to the arena bounds. */
+	UPROPERTY()
+	uint16 QuantizedX = 0;
+
+	/** Quantized Y position relative to the arena bounds. */
+	UPROPERTY()
+	uint16 QuantizedY = 0;
+
+	/** Quantized Z position relative to the arena bounds. */
+	UPROPERTY()
+	uint16 QuantizedZ = 0;
+
+	/** Quantized yaw, in 256 steps per turn. */
+	UPROPERTY()
+	uint8 QuantizedYaw = 0;
+
+	/** Samples received by the client, oldest first. Never replicated. */
+	TArray<FEnemyMovementSample> Samples = TArray<FEnemyMovementSample>();
+
+	/**
+	 * Called on the client when the item is received for the first time. Starts the jitter buffer at the received movement.
+	 * @param InArraySerializer The array holding the item.
+	 */
+	void PostReplicatedAdd(const FEnemyMovementArray& InArraySerializer);
+
+	/**
+	 * Called on the client when a new movement of the item is received. Appends it to the jitter buffer.
+	 * @param InArraySerializer The array holding the item.
+	 */
+	void PostReplicatedChange(const FEnemyMovementArray& InArraySerializer);
+
+	/**
+	 * Appends the received movement to the jitter buffer, dropping the oldest sample when it is full.
+	 * @param Time The local world time when the movement was received.
+	 */
+	void AddSample(const float Time);
+};
+
+/**
+ * FEnemyMovementArray
+ *
+ * Fast array of the movement of every active enemy of a pool, so only the items that changed since the last update
+ * are sent, all of them in the bunch of a single actor channel.
+ */
+USTRUCT()
+struct FEnemyMovementArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor. Initializes an empty array. */
+	FEnemyMovementArray() {}
+
+	/** Movement of every active enemy. */
+	UPROPERTY()
+	TArray<FEnemyMovementItem> Items = TArray<FEnemyMovementItem>();
+
+	/** Proxy owning the array, giving the received samples their time. */
+	AEnemyMovementProxy* Owner = nullptr;
+
+	/**
+	 * Serializes the items changed since the last acknowledged state.
+	 * @param DeltaParms The delta serialization parameters.
+	 * @return True if the serialization succeeded.
+	 */
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FEnemyMovementItem, FEnemyMovementArray>(Items, DeltaParms, *this);
+	}
+};
+
+/** Type traits enabling the delta serializer of FEnemyMovementArray. */
+template<>
+struct TStructOpsTypeTraits<FEnemyMovementArray> : public TStructOpsTypeTraitsBase2<FEnemyMovementArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true
+	};
+};
+
+/**
+ * AEnemyMovementProxy
+ *
+ * Always relevant actor replicating the movement of every active enemy of a pool in one fast array, instead of one
+ * full precision movement update per enemy actor channel.
+ * On the server it samples the registered enemies at its net update frequency and quantizes their position relative to
+ * the arena bounds; on clients it interpolates every enemy from a short jitter buffer of received samples, in one pass.
+ * Enemies registered in the proxy stop replicating their own movement.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class QORPOTESTJULIAN_API AEnemyMovementProxy : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor. Sets up replication and the owner of the movement array. */
+	AEnemyMovementProxy();
+
+	/**
+	 * Sets the arena bounds the positions are quantized against, grown by the arena margin.
+	 * @param ArenaBounds The bounds every active enemy moves within.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replication")
+	void SetArenaBounds(const FBox& ArenaBounds);
+
+	/**
+	 * Starts replicating the movement of an enemy through the proxy, turning off its own movement replication.
+	 * @param Enemy The enemy to replicate.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replication")
+	void RegisterEnemy(ABaseEnemy* Enemy);
+
+	/**
+	 * Returns the local world time of the client, used to timestamp the received samples.
+	 * @return The world time in seconds.
+	 */
+	const float GetSampleTime() const;
+
+	/**
+	 * Called when the game starts or when spawned.
+	 * On the server, reports the interpolation delay to the lag compensation subsystem.
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * Called every frame.
+	 * Samples the registered enemies on the server, or interpolates them from their jitter buffers on clients.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * Called on the server before the proxy is replicated.
+	 * Reports the estimated movement bandwidth per active enemy.
+	 * @param ChangedPropertyTracker The tracker of the properties changed since the last replication.
+	 */
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+protected:
+	/** Times per second the enemies are sampled and the proxy is considered for replication. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication", meta = (ClampMin = 1.0f, ClampMax = 60.0f))
+	float UpdateFrequency = 20.0f;
+
+	/**
+	 * Time in seconds clients render the enemies behind the last received sample; should cover two updates and the jitter.
+	 * Remote shots are rewound by this delay on top of the shooter's round trip, so the lag compensation MaxRewindTime
+	 * should cover it plus the highest round trip to compensate.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float InterpolationDelay = 0.1f;
+
+	/** Distance the arena bounds are grown by on every side, so enemies slightly outside the navigation bounds are not clamped. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication", meta = (ClampMin = 0.0f, ClampMax = 10000.0f))
+	float ArenaMargin = 1000.0f;
+
+	/** Minimum corner of the arena bounds. */
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Replication")
+	FVector ArenaOrigin = FVector::ZeroVector;
+
+	/** Size of the arena bounds along every axis. */
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Replication")
+	FVector ArenaSize = FVector(1.0f);
+
+	/** Movement of every active enemy. */
+	UPROPERTY(Replicated)
+	FEnemyMovementArray Movement = FEnemyMovementArray();
+
+	/** Enemies registered on the server. */
+	TArray<TWeakObjectPtr<ABaseEnemy>> Enemies = TArray<TWeakObjectPtr<ABaseEnemy>>();
+
+	/** Index in the movement array of every active enemy, on the server. */
+	TMap<const ABaseEnemy*, int> ItemIndices = TMap<const ABaseEnemy*, int>();
+
+	/** Number of items changed since the last replication, on the server. */
+	int ChangedItems = 0;
+
+	/** World time of the last replication, on the server. */
+	float LastReplicationTime = 0.0f;
+
+	/** Sets the sampling interval on the server. */
+	virtual void BeginPlay() override;
+
+	/**
+	 * Registers properties for network replication.
+	 * @param OutLifetimeProps The array to add replicated properties to.
+	 */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Quantizes the movement of every active registered enemy, adding, updating and removing items as needed. */
+	void SampleEnemies();
+
+	/** Moves every enemy of the array to its interpolated movement. */
+	void InterpolateEnemies();
+};
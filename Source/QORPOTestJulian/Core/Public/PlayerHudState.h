@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PlayerHudState.generated.h"
+
+/**
+ * FPlayerHudState
+ *
+ * Compact state of the values displayed by the player's HUD: health and maximum health quantized to tenths of a point,
+ * ammunition and magazine packed in the smallest integers that fit them.
+ * Replicated as a property, so only the members that changed since the last update are sent.
+ *
+ * This struct is designed to be replicated to the owning client of a player controller only.
+ */
+USTRUCT(BlueprintType)
+struct FPlayerHudState
+{
+	GENERATED_BODY()
+
+public:
+	/** Precision of the quantized health values, in health points per unit. */
+	static constexpr float HealthQuantum = 0.1f;
+
+	/** Default constructor. Initializes an empty state. */
+	FPlayerHudState() {}
+
+	/** Current health in tenths of a health point. */
+	UPROPERTY(VisibleAnywhere, Category = "HUD")
+	uint16 QuantizedHealth = 0;
+
+	/** Maximum health in tenths of a health point. */
+	UPROPERTY(VisibleAnywhere, Category = "HUD")
+	uint16 QuantizedMaxHealth = 0;
+
+	/** Ammunition carried by the player. */
+	UPROPERTY(VisibleAnywhere, Category = "HUD")
+	uint16 Ammunition = 0;
+
+	/** Bullets in the magazine of the current weapon. */
+	UPROPERTY(VisibleAnywhere, Category = "HUD")
+	uint8 Magazine = 0;
+
+	/**
+	 * Sets the health values, rounded up so a living player never shows zero health.
+	 * @param Health The current health.
+	 * @param MaxHealth The maximum health.
+	 * @return True if any quantized value changed.
+	 */
+	bool SetHealth(const float Health, const float MaxHealth)
+	{
+		const uint16 NewHealth = uint16(FMath::Clamp(FMath::CeilToInt(Health / HealthQuantum), 0, int(MAX_uint16)));
+		const uint16 NewMaxHealth = uint16(FMath::Clamp(FMath::CeilToInt(MaxHealth / HealthQuantum), 0, int(MAX_uint16)));
+		const bool bChanged = NewHealth != QuantizedHealth || NewMaxHealth != QuantizedMaxHealth;
+		QuantizedHealth = NewHealth;
+		QuantizedMaxHealth = NewMaxHealth;
+
+		return bChanged;
+	}
+
+	/**
+	 * Sets the ammunition carried by the player.
+	 * @param Amount The ammunition amount.
+	 * @return True if the packed value changed.
+	 */
+	bool SetAmmunition(const int Amount)
+	{
+		const uint16 NewAmmunition = uint16(FMath::Clamp(Amount, 0, int(MAX_uint16)));
+		const bool bChanged = NewAmmunition != Ammunition;
+		Ammunition = NewAmmunition;
+
+		return bChanged;
+	}
+
+	/**
+	 * Sets the bullets in the magazine of the current weapon.
+	 * @param Amount The magazine amount.
+	 * @return True if the packed value changed.
+	 */
+	bool SetMagazine(const int Amount)
+	{
+		const uint8 NewMagazine = uint8(FMath::Clamp(Amount, 0, int(MAX_uint8)));
+		const bool bChanged = NewMagazine != Magazine;
+		Magazine = NewMagazine;
+
+		return bChanged;
+	}
+
+	/**
+	 * Returns the current health.
+	 * @return The health in health points.
+	 */
+	float GetHealth() const
+	{
+		return QuantizedHealth * HealthQuantum;
+	}
+
+	/**
+	 * Returns the maximum health.
+	 * @return The maximum health in health points.
+	 */
+	float GetMaxHealth() const
+	{
+		return QuantizedMaxHealth * HealthQuantum;
+	}
+};
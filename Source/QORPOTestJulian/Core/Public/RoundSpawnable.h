@@ -5,6 +5,7 @@
 #include "RoundSpawnable.generated.h"
 
 class ABaseEnemy;
+class AEnemyMovementProxy;
 
 /**
  * FRoundSpawnable
@@ -31,6 +32,13 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Data")
 	TArray<ABaseEnemy*> EnemiesContainer = TArray<ABaseEnemy*>();
 
+	/**
+	 * Proxy replicating the movement of every active enemy of the pool, if the game mode uses one.
+	 * Spawned at runtime along with the enemies.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Data")
+	AEnemyMovementProxy* MovementProxy = nullptr;
+
 	/**
 	 * The altitude (Z coordinate) at which enemies should be spawned for this round.
 	 * Can be used to control vertical placement of enemies in the level.
@@ -5,6 +5,8 @@
 #include "NavMesh/NavMeshBoundsVolume.h"
 #include "EngineUtils.h"
 #include "RoundSpawnable.h"
+#include "ShooterGameState.h"
+#include "EnemyMovementProxy.h"
 #include "ShooterPlayerController.h"
 #include "../../Characters/Public/ShooterPlayer.h"
 #include "../../Characters/Public/BaseEnemy.h"
@@ -22,6 +24,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoundStarted, const int, Round);
  *
  * Main game mode class for the shooter game.
  * Manages round logic, enemy spawning, round progression, and navigation mesh bounds.
+ * The match clock and the current round are published to every player through the shooter game state.
  * Handles the lifecycle of enemies and rounds, and provides Blueprint and C++ hooks for round events.
  *
  * This class is designed to be extended and supports both C++ and Blueprint customization.
@@ -36,7 +39,7 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnRoundStarted OnRoundStarted;
 
-	/** Default constructor. Initializes default values and sets up round management. */
+	/** Default constructor. Initializes default values, the game state class and sets up round management. */
 	AShooterGameModeBase();
 
 protected:
@@ -72,6 +75,13 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Map|Round")
 	FTimerHandle BetweenRoundsTimerHandle = FTimerHandle();
 
+	/**
+	 * Class of the proxy spawned per enemy pool to replicate the movement of its active enemies.
+	 * If unset, every enemy replicates its own movement.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Map")
+	TSubclassOf<AEnemyMovementProxy> EnemyMovementProxyClass = AEnemyMovementProxy::StaticClass();
+
 	/**
 	 * Position used to hide enemies when not active (e.g., between rounds).
 	 */
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+
+#include "ShooterGameState.generated.h"
+
+/**
+ * Delegate broadcast when the current round changes, on the server and on every client.
+ * @param Round The current round number.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoundUpdated, const int, Round);
+
+/**
+ * AShooterGameState
+ *
+ * Game state of the shooter game, replicating the match clock and the current round once for every player.
+ * Only the server time when the match started is replicated; every machine derives the elapsed match time from the
+ * server world time the base game state already keeps in sync, so the clock costs no bandwidth while it runs.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class QORPOTESTJULIAN_API AShooterGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+
+public:
+	/** Event triggered when the current round changes. */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnRoundUpdated OnRoundUpdated;
+
+	/**
+	 * Starts the match clock at the current server time. Only called on the server.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Match")
+	void StartMatchClock();
+
+	/**
+	 * Sets the current round and broadcasts the OnRoundUpdated event. Only called on the server.
+	 * @param Round The new round number.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Match")
+	void SetCurrentRound(const int Round);
+
+	/**
+	 * Returns the current round.
+	 * @return The current round number.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Match")
+	const int GetCurrentRound() const;
+
+	/**
+	 * Returns whether the match clock has started.
+	 * @return True once the server started the clock and its start time has been received.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Match")
+	const bool HasMatchStarted() const;
+
+	/**
+	 * Returns the time elapsed since the match started, derived from the synchronized server world time.
+	 * @return The match time in seconds, or zero before the match starts.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Match")
+	const float GetMatchTime() const;
+
+protected:
+	/** Server world time when the match started, or a negative value before it starts. */
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Match")
+	double MatchStartTime = -1.0;
+
+	/** The current round number. */
+	UPROPERTY(ReplicatedUsing = OnReplicateCurrentRound, VisibleAnywhere, BlueprintReadOnly, Category = "Match")
+	int CurrentRound = 0;
+
+	/**
+	 * Registers properties for network replication.
+	 * @param OutLifetimeProps The array to add replicated properties to.
+	 */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/**
+	 * Called when the CurrentRound property is replicated.
+	 * Broadcasts the OnRoundUpdated event.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Match")
+	void OnReplicateCurrentRound();
+};
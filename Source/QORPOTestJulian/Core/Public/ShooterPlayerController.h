@@ -3,11 +3,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "../../UserInterface/Public/PlayerWidget.h"
+#include "PlayerHudState.h"
+#include "ShooterGameState.h"
 
 #include "ShooterPlayerController.generated.h"
 
 /**
- * Delegate broadcast when the survive time is updated.
+ * Delegate broadcast when the survive time is updated, on the local controller only.
  * @param Seconds The new survive time in seconds.
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSurviveTimeUpdated, const float, Seconds);
@@ -23,6 +25,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnScoreUpdated, const int, Score);
  *
  * Custom player controller for the shooter game.
  * Manages player input, UI widget creation, score, survive time tracking, and networked events.
+ * The values displayed by the HUD reach the owning client in a single compact state replicated to the owner only,
+ * while the round is read from the game state shared by every player and the survive time from the possessed player.
  * Handles replication of key player data and provides Blueprint and C++ hooks for UI and gameplay events.
  */
 UCLASS(Blueprintable, BlueprintType)
@@ -58,15 +62,14 @@ public:
 	void UpdateScore(const float Points);
 
 	/**
-	 * Server-side function to apply damage to a target actor.
+	 * Applies damage dealt by one of the player's actors.
+	 * Damage is only dealt by the server; calls on clients are ignored.
 	 * @param DamageReceiver The actor receiving damage.
 	 * @param DamageAmount The amount of damage to apply.
 	 * @param DamageEvent The damage event struct.
-	 * @param EventInstigator The controller responsible for the damage.
 	 * @param DamageCauser The actor causing the damage.
 	 */
-	UFUNCTION(Server, Unreliable, BlueprintCallable, Category = "Net")
-	void Server_DoDamage(AActor* DamageReceiver, float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser);
+	void DoDamage(AActor* DamageReceiver, const float DamageAmount, FDamageEvent const& DamageEvent, AActor* DamageCauser);
 
 protected:
 	/** Reference to the player's UI widget instance. */
@@ -77,19 +80,31 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Data|UI")
 	TSubclassOf<UPlayerWidget> PlayerWidgetClass = nullptr;
 
-	/** The total time the player has survived, replicated to clients. */
-	UPROPERTY(ReplicatedUsing = OnReplicateSurviveTime, VisibleAnywhere, BlueprintReadWrite, Category = "Data", meta = (ClampMin = 0.0f, ClampMax = 9999999999.0f))
+	/** The total time the player has survived, derived locally from the spawn time of the possessed player. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Data", meta = (ClampMin = 0.0f, ClampMax = 9999999999.0f))
 	float SurviveTime = 0.0f;
 
+	/** Time in seconds between two updates of the survive time on the local controller. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Data", meta = (ClampMin = 0.1f, ClampMax = 10.0f))
+	float SurviveTimeUpdateInterval = 1.0f;
+
+	/** Timer handle used to update the survive time on the local controller. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Data")
+	FTimerHandle SurviveTimeTimerHandle = FTimerHandle();
+
 	/** The current score of the player, replicated to clients. */
 	UPROPERTY(ReplicatedUsing = OnReplicatedCurrentScore, VisibleAnywhere, BlueprintReadWrite, Category = "Data", meta = (ClampMin = 0.0f, ClampMax = 9999999999.0f))
 	float CurrentScore = 0.0f;
 
+	/** Health, ammunition and magazine displayed by the HUD, replicated to the owner only. */
+	UPROPERTY(ReplicatedUsing = OnReplicateHudState, VisibleAnywhere, BlueprintReadOnly, Category = "Data|UI")
+	FPlayerHudState HudState = FPlayerHudState();
+
 	/** Whether the pitch input is inverted for this player. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Data|Options")
 	bool bInvertPitch = false;
 
-	/** Called when the game starts or when spawned. Initializes UI and player data. */
+	/** Called when the game starts or when spawned. Initializes UI and, on the local controller, the survive time updates. */
 	virtual void BeginPlay() override;
 
 	/**
@@ -98,18 +113,19 @@ protected:
 	 */
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
-	/**
-	 * Called every frame. Handles per-tick logic such as survive time updates.
-	 * @param DeltaTime Time elapsed since the last tick.
-	 */
-	virtual void Tick(float DeltaTime) override;
-
 	/**
 	 * Called when this controller possesses a new pawn.
 	 * @param InPawn The pawn being possessed.
 	 */
 	virtual void OnPossess(APawn* InPawn) override;
 
+	/**
+	 * Called on the owning client when the possession of a pawn is acknowledged.
+	 * Binds to the magazine events of the local player so predicted shots update the UI right away.
+	 * @param InPawn The possessed pawn.
+	 */
+	virtual void AcknowledgePossession(APawn* InPawn) override;
+
 	/**
 	 * Called when the controller is removed from the world.
 	 * Cleans up UI and event bindings.
@@ -118,23 +134,22 @@ protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/**
-	 * Updates the survive time for the player and broadcasts the event.
+	 * Updates the survive time for the player from the lifetime of its pawn and broadcasts the event.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Data")
 	void UpdateSurviveTime();
 
 	/**
-	 * Creates and initializes the player's UI widget.
+	 * Returns the game state, binding to its round events the first time it is available on this machine.
+	 * @return The shooter game state, or null if it has not been received yet.
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Data|UI")
-	void CreatePlayerWidget();
+	AShooterGameState* BindShooterGameState();
 
 	/**
-	 * Called when the SurviveTime property is replicated.
-	 * Broadcasts the OnSurviveTimeUpdated event.
+	 * Creates and initializes the player's UI widget.
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Data")
-	void OnReplicateSurviveTime();
+	UFUNCTION(BlueprintCallable, Category = "Data|UI")
+	void CreatePlayerWidget();
 
 	/**
 	 * Called when the CurrentScore property is replicated.
@@ -144,31 +159,44 @@ protected:
 	void OnReplicatedCurrentScore();
 
 	/**
-	 * Multicast function to update the player's health in the UI on all clients.
+	 * Called when the HudState property is replicated.
+	 * Updates every value of the UI from it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Data|UI")
+	void OnReplicateHudState();
+
+	/**
+	 * Updates the health, ammunition and magazine of the UI from the HUD state.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Data|UI")
+	void RefreshPlayerWidget();
+
+	/**
+	 * Updates the player's health in the HUD state on the server and in the UI.
 	 * @param CurrentHealth The current health value.
 	 * @param MaxHealth The maximum health value.
 	 */
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Data|UI")
-	void Multicast_HandleHealthUpdated(const float CurrentHealth, const float MaxHealth);
+	UFUNCTION(BlueprintCallable, Category = "Data|UI")
+	void HandleHealthUpdated(const float CurrentHealth, const float MaxHealth);
 
 	/**
-	 * Multicast function to update the current round in the UI on all clients.
+	 * Updates the current round in the UI.
 	 * @param CurrentRound The current round number.
 	 */
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Data|UI")
-	void Multicast_HandleRoundUpdated(const int CurrentRound);
+	UFUNCTION(BlueprintCallable, Category = "Data|UI")
+	void HandleRoundUpdated(const int CurrentRound);
 
 	/**
-	 * Multicast function to update the player's ammunition in the UI on all clients.
+	 * Updates the player's ammunition in the HUD state on the server and in the UI.
 	 * @param CurrentAmmunition The current ammunition value.
 	 */
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Data|UI")
-	void Multicast_HandlePlayerAmmunitionUpdated(const int CurrentAmmunition);
+	UFUNCTION(BlueprintCallable, Category = "Data|UI")
+	void HandlePlayerAmmunitionUpdated(const int CurrentAmmunition);
 
 	/**
-	 * Multicast function to update the weapon's magazine in the UI on all clients.
+	 * Updates the weapon's magazine in the HUD state on the server and in the UI.
 	 * @param Magazine The current magazine value.
 	 */
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Data|UI")
-	void Multicast_HandleWeaponMagazineUpdated(const int Magazine);
+	UFUNCTION(BlueprintCallable, Category = "Data|UI")
+	void HandleWeaponMagazineUpdated(const int Magazine);
 };
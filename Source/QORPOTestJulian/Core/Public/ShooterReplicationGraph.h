@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+
+#include "ShooterReplicationGraph.generated.h"
+
+/**
+ * UShooterReplicationGraph
+ *
+ * Replication graph of the shooter, replacing the per-actor relevancy checks of the net driver.
+ * Enemies, projectiles, barrels, items and doors are spatialized in a 2D grid, so every connection only gathers the actors
+ * of the cells around its viewers; reusable (pooled) actors are added through the dormancy aware path, so a pooled-off
+ * dormant actor costs nothing until it wakes up. Players, the game state and the player states are always relevant, and
+ * owner-only actors (player controllers) are gathered by the per-connection node.
+ *
+ * Enabled by setting it as the replication driver of the IP net driver in DefaultEngine.ini.
+ */
+UCLASS(transient, config = Engine)
+class QORPOTESTJULIAN_API UShooterReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	/** Sets the replication period and cull distance of every replicated actor class from its defaults. */
+	virtual void InitGlobalActorClassSettings() override;
+
+	/** Creates the spatialization grid and the always relevant node shared by every connection. */
+	virtual void InitGlobalGraphNodes() override;
+
+	/**
+	 * Creates the always relevant node of a connection, gathering its controller, pawn and view target.
+	 * @param RepGraphConnection The connection being initialized.
+	 */
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+
+	/**
+	 * Routes a new replicated actor to the always relevant node or the spatialization grid.
+	 * @param ActorInfo The actor being added.
+	 * @param GlobalInfo The global replication info of the actor.
+	 */
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+
+	/**
+	 * Removes a replicated actor from the node it was routed to.
+	 * @param ActorInfo The actor being removed.
+	 */
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	/**
+	 * Replicates the actors of every connection, reporting the server replication time per connection.
+	 * @param DeltaSeconds Time elapsed since the last replication.
+	 * @return The number of actors replicated.
+	 */
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	/**
+	 * Overrides the replication period of an actor, which otherwise follows the settings of its class.
+	 * @param Actor The actor to update.
+	 * @param Frequency The new replication frequency.
+	 */
+	void SetActorReplicationFrequency(AActor* Actor, const float Frequency);
+
+protected:
+	/** Size in units of the cells of the spatialization grid; roughly the distance an actor stays relevant. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (ClampMin = 500.0f, ClampMax = 100000.0f))
+	float GridCellSize = 10000.0f;
+
+	/** Offset of the grid origin, set below the lowest coordinates of the arena so every cell index stays positive. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Replication")
+	FVector2D GridSpatialBias = FVector2D(-100000.0f, -100000.0f);
+
+	/** Node gathering the spatialized actors of the cells around every viewer. */
+	UPROPERTY(Transient)
+	UReplicationGraphNode_GridSpatialization2D* GridNode = nullptr;
+
+	/** Node gathering the actors relevant to every connection. */
+	UPROPERTY(Transient)
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode = nullptr;
+
+	/**
+	 * Returns whether an actor is replicated to every connection regardless of its position.
+	 * @param Actor The actor to check.
+	 * @return True for players, the game state, player states and actors flagged always relevant.
+	 */
+	const bool IsAlwaysRelevant(const AActor* Actor) const;
+
+	/**
+	 * Returns whether an actor is pooled and spatialized through the dormancy aware path.
+	 * @param Actor The actor to check.
+	 * @return True for actors implementing the reusable interface.
+	 */
+	const bool IsReusable(const AActor* Actor) const;
+};
@@ -9,6 +9,7 @@
  */
 
 #include "../Public/AmmunitionPackage.h"
+#include "../../QORPOTestJulian.h"
 
 /**
  * Called when another actor begins to overlap with this ammunition package.
@@ -20,6 +21,7 @@ void AAmmunitionPackage::NotifyActorBeginOverlap(AActor* OtherActor)
 {
 	Super::NotifyActorBeginOverlap(OtherActor);
 
+	INC_DWORD_STAT(STAT_GameplayOverlapEvents);
 	Execute_OnInteract(this, OtherActor);
 }
 
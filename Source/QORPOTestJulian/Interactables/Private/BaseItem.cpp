@@ -9,10 +9,12 @@
  */
 
 #include "../Public/BaseItem.h"
+#include "../../Subsystems/Public/NetActivitySubsystem.h"
 
 /**
  * Default constructor.
  * Initializes components, sets up collision, movement, and replication properties.
+ * The mesh uses the pickup profile, so it only generates overlaps with players.
  */
 ABaseItem::ABaseItem()
 {
@@ -23,14 +25,14 @@ ABaseItem::ABaseItem()
 	SetRootComponent(CreateDefaultSubobject<USceneComponent>(FName("RootComponent")));
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(FName("MeshComponent"));
-	MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	MeshComponent->SetCollisionResponseToAllChannels(ECR_Overlap);
+	MeshComponent->SetCollisionProfileName(FName("Pickup"));
 	MeshComponent->SetupAttachment(GetRootComponent());
 }
 
 /**
  * Called when the game starts or when spawned.
  * Registers the mesh as an enabled type and stores the original position and rotation.
+ * On the server, also registers the item for adaptive net update frequency.
  */
 void ABaseItem::BeginPlay()
 {
@@ -38,6 +40,12 @@ void ABaseItem::BeginPlay()
 
 	Execute_AddEnabledType(this, MeshComponent);
 	Execute_SetOriginalPositionAndRotation(this, GetActorLocation(), GetActorRotation());
+
+	UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+	if (HasAuthority() && IsValid(NetActivity))
+	{
+		NetActivity->RegisterActor(this);
+	}
 }
 
 /**
@@ -55,7 +63,7 @@ void ABaseItem::Tick(float DeltaTime)
 
 /**
  * Called when the item is removed from the world.
- * Clears all timers associated with this item.
+ * Clears all timers associated with this item and stops adapting its net update frequency.
  *
  * @param EndPlayReason The reason for removal.
  */
@@ -64,6 +72,12 @@ void ABaseItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 
 	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+	if (IsValid(NetActivity))
+	{
+		NetActivity->UnregisterActor(this);
+	}
 }
 
 /**
@@ -9,24 +9,27 @@
  */
 
 #include "../Public/Door.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 /**
  * Default constructor.
  * Initializes components, sets up collision, movement, and replication properties for the door.
+ * The mesh is only found by the interaction traces of the players and generates no overlaps.
+ * The door starts dormant and only stays awake while it is animating.
  */
 ADoor::ADoor()
 {
 	PrimaryActorTick.bCanEverTick = true;
 	SetReplicates(true);
 	SetReplicateMovement(true);
+	NetDormancy = DORM_Initial;
 
 	SetRootComponent(CreateDefaultSubobject<USceneComponent>(FName("RootComponent")));
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(FName("MeshComponent"));
 	MeshComponent->SetCanEverAffectNavigation(true);
 	MeshComponent->SetMobility(EComponentMobility::Movable);
-	MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	MeshComponent->SetCollisionResponseToAllChannels(ECR_Overlap);
+	MeshComponent->SetCollisionProfileName(FName("Interactable"));
 	MeshComponent->SetupAttachment(GetRootComponent());
 	SetRootComponent(MeshComponent);
 
@@ -59,19 +62,24 @@ void ADoor::BeginPlay()
 	DesiredRotation = (OriginalRotation.GetManhattanDistance(OriginalRotation + CloseRotationOffset) 
 		< OriginalRotation.GetManhattanDistance(OriginalRotation + OpenRotationOffset) 
 		? CloseRotationOffset : OpenRotationOffset) + OriginalRotation;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ADoor, DesiredPosition, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ADoor, DesiredRotation, this);
 }
 
 /**
  * Registers properties for network replication.
+ * The animation targets are push based, marked dirty only when the door is toggled or its animation ends.
  * @param OutLifetimeProps The array to add replicated properties to.
  */
 void ADoor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ADoor, DesiredPosition);
-	DOREPLIFETIME(ADoor, DesiredRotation);
-	DOREPLIFETIME(ADoor, bActiveAnimation);
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ADoor, DesiredPosition, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ADoor, DesiredRotation, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ADoor, bActiveAnimation, Params);
 }
 
 /**
@@ -88,24 +96,32 @@ void ADoor::Tick(float DeltaTime)
 
 /**
  * Called when this door is interacted with (e.g., by a player).
- * Toggles the door's open/close state and starts the animation.
+ * Toggles the door's open/close state and starts the animation, waking the door up on the server.
  * @param Caller The actor that initiated the interaction.
  */
 void ADoor::OnInteract_Implementation(AActor* Caller)
 {
 	if (IsValid(Caller) && !bActiveAnimation)
 	{
+		if (HasAuthority())
+		{
+			SetNetDormancy(DORM_Awake);
+		}
+
 		DesiredPosition = (DesiredPosition.Equals(OriginalPosition + ClosePositionOffset, PositionToleranceOffset) ?
 			OpenPositionOffset : ClosePositionOffset) + OriginalPosition;
 		DesiredRotation = (DesiredRotation.EqualsOrientation(OriginalRotation + CloseRotationOffset, RotationToleranceOffset) ?
 			OpenRotationOffset : CloseRotationOffset) + OriginalRotation;
 		bActiveAnimation = true;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ADoor, DesiredPosition, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(ADoor, DesiredRotation, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(ADoor, bActiveAnimation, this);
 	}
 }
 
 /**
  * Handles the door's animation each tick, moving and rotating the door towards its desired state.
- * Animation completes when both position and rotation reach their targets.
+ * Animation completes when both position and rotation reach their targets, sending the door back to dormancy on the server.
  * @param DeltaTime Time elapsed since the last tick.
  */
 void ADoor::OnInteractionAnimation_Implementation(const float DeltaTime)
@@ -140,5 +156,11 @@ void ADoor::OnInteractionAnimation_Implementation(const float DeltaTime)
 	if (bPositionComplete && bRotationComplete)
 	{
 		bActiveAnimation = false;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ADoor, bActiveAnimation, this);
+		if (HasAuthority())
+		{
+			ForceNetUpdate();
+			SetNetDormancy(DORM_DormantAll);
+		}
 	}
 }
\ No newline at end of file
@@ -6,21 +6,49 @@
  *
  * This class handles damage processing, explosion effects, radial damage application, and networked state.
  * It is designed to be extended and supports both C++ and Blueprint customization.
+ * Resting barrels sleep early and stay network dormant; their wake and sleep events toggle the dormancy on the server.
+ * Barrels opting into async physics detect rest on the fixed physics step, independently of the frame rate.
  */
 
 #include "../Public/ExplosiveBarrel.h"
+#include "../../Subsystems/Public/DamageSubsystem.h"
+#include "../../Subsystems/Public/ExplosionSubsystem.h"
+#include "../../Subsystems/Public/NetActivitySubsystem.h"
+#include "../../QORPOTestJulian.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Awake Barrels"), STAT_AwakeBarrels, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Barrel Movement Updates"), STAT_BarrelMovementUpdates, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Barrel Movement Bytes"), STAT_BarrelMovementBytes, STATGROUP_QORPOTestJulian);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Barrel Movement Bytes Per Awake Barrel"), STAT_BarrelMovementBytesPerAwakeBarrel, STATGROUP_QORPOTestJulian);
+DECLARE_CYCLE_STAT(TEXT("Async Barrel Step"), STAT_AsyncBarrelStep, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Barrel Sleeps"), STAT_AsyncBarrelSleeps, STATGROUP_QORPOTestJulian);
+
+/** Estimated size in bytes of a barrel movement update: header, quantized location, rotation, and linear and angular velocities. */
+static constexpr int EstimatedMovementUpdateBytes = 24;
+
+/** Number of barrels whose body is awake, across every world. */
+static int AwakeBarrelCount = 0;
 
 /**
  * Default constructor.
  * Initializes all components, sets up collision, physics, and replication properties for the explosive barrel.
+ * The barrel starts network dormant and replicates its movement through predictive interpolation once awake.
+ * Its body sleeps at four times the default thresholds, tunable through the sleep settings of the mesh body.
  */
 AExplosiveBarrel::AExplosiveBarrel()
 {
 	SetReplicates(true);
 	SetReplicateMovement(true);
+	SetPhysicsReplicationMode(EPhysicsReplicationMode::PredictiveInterpolation);
+	NetDormancy = DORM_Initial;
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(FName("MeshComponent"));
 	MeshComponent->SetSimulatePhysics(true);
+	MeshComponent->SetGenerateWakeEvents(true);
+	MeshComponent->BodyInstance.SleepFamily = ESleepFamily::Custom;
+	MeshComponent->BodyInstance.CustomSleepThresholdMultiplier = 4.0f;
 	MeshComponent->SetCanEverAffectNavigation(false);
 	MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 	MeshComponent->SetCollisionResponseToAllChannels(ECR_Block);
@@ -54,8 +82,8 @@ AExplosiveBarrel::AExplosiveBarrel()
 
 /**
  * Processes incoming damage events for this barrel.
- * Handles different types of damage events (point, radial, generic) and updates health accordingly.
- * Applies physics impulses on radial damage.
+ * Queues the damage in the damage subsystem, which applies the net health change of the frame in one batch.
+ * Radial damage is not scaled by its base damage, only by its falloff; explosions push the barrel through a physics field.
  *
  * @param DamageAmount The amount of damage.
  * @param DamageEvent The event describing the type of damage.
@@ -71,43 +99,78 @@ float AExplosiveBarrel::TakeDamage(float DamageAmount, FDamageEvent const& Damag
 		return DamageResult;
 	}
 
-	switch (DamageEvent.GetTypeID())
+	UDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UDamageSubsystem>();
+	if (IsValid(DamageSubsystem))
 	{
-	case FDamageEvent::ClassID:
-	{
-		DamageResult = -abs(DamageAmount);
-		AttributesComponent->HealthReaction(-abs(DamageAmount));
-		break;
+		FQueuedDamage Damage = UDamageSubsystem::MakeQueuedDamage(this, AttributesComponent, DamageAmount, DamageEvent, EventInstigator);
+		Damage.Amount = Damage.bRadial ? 1.0f : Damage.Amount;
+		DamageResult = DamageSubsystem->QueueDamage(Damage);
 	}
-	case FPointDamageEvent::ClassID:
+
+	return DamageResult;
+}
+
+/**
+ * Called on the server before the barrel is replicated.
+ * Reports the estimated movement bandwidth of the barrel while its body is awake; every awake barrel adds its share
+ * to the per-barrel counter, so the counter shows the average bytes per awake barrel each frame.
+ *
+ * @param ChangedPropertyTracker The tracker of the properties changed since the last replication.
+ */
+void AExplosiveBarrel::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	if (!bPhysicsAwake || AwakeBarrelCount <= 0)
 	{
-		DamageResult = -abs(DamageAmount);
-		AttributesComponent->HealthReaction(-abs(DamageAmount));
-		break;
+		return;
 	}
-	case FRadialDamageEvent::ClassID:
+
+	INC_DWORD_STAT(STAT_BarrelMovementUpdates);
+	INC_DWORD_STAT_BY(STAT_BarrelMovementBytes, EstimatedMovementUpdateBytes);
+	INC_FLOAT_STAT_BY(STAT_BarrelMovementBytesPerAwakeBarrel, float(EstimatedMovementUpdateBytes) / AwakeBarrelCount);
+}
+
+/**
+ * Called on the physics thread every fixed async physics step when the barrel uses async physics.
+ * Puts the barrel body to sleep once its speeds stayed under the rest thresholds for the rest delay, measured in
+ * simulated time so it does not depend on the frame rate. The sleep event reaches the game thread as usual.
+ *
+ * @param DeltaTime The fixed step duration.
+ * @param SimTime The total simulated time.
+ */
+void AExplosiveBarrel::AsyncPhysicsTickActor(float DeltaTime, float SimTime)
+{
+	Super::AsyncPhysicsTickActor(DeltaTime, SimTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_AsyncBarrelStep);
+
+	const FBodyInstance* BodyInstance = IsValid(MeshComponent) ? MeshComponent->GetBodyInstance() : nullptr;
+	FPhysicsActorHandle Handle = BodyInstance != nullptr ? BodyInstance->GetPhysicsActorHandle() : nullptr;
+	Chaos::FRigidBodyHandle_Internal* Body = Handle != nullptr ? Handle->GetPhysicsThreadAPI() : nullptr;
+	if (Body == nullptr || Body->ObjectState() != Chaos::EObjectStateType::Dynamic)
 	{
-		const FRadialDamageEvent& RadialEvent = static_cast<const FRadialDamageEvent&>(DamageEvent);
-		const FVector& CurrentPosition = GetActorLocation();
-		const FVector& RadialPosition = RadialEvent.Origin;
-		DamageResult = -abs(RadialEvent.Params.GetDamageScale(FVector::Distance(CurrentPosition, RadialPosition)));
-		AttributesComponent->HealthReaction(DamageResult);
-		if (IsValid(MeshComponent))
-		{
-			MeshComponent->AddImpulseAtLocation((CurrentPosition - RadialPosition).GetSafeNormal() * DamageResult * DamageAmount, RadialPosition);
-		}
-		break;
-	}
-	default:
-		break;
+		AsyncRestTime = 0.0f;
+
+		return;
 	}
 
-	return DamageResult;
+	const bool bResting = Body->V().SizeSquared() < FMath::Square(AsyncRestLinearSpeed) && Body->W().SizeSquared() < FMath::Square(AsyncRestAngularSpeed);
+	AsyncRestTime = bResting ? AsyncRestTime + DeltaTime : 0.0f;
+	if (AsyncRestTime >= AsyncRestDelay)
+	{
+		Body->SetObjectState(Chaos::EObjectStateType::Sleeping, true);
+		AsyncRestTime = 0.0f;
+		INC_DWORD_STAT(STAT_AsyncBarrelSleeps);
+	}
 }
 
 /**
  * Called when the game starts or when spawned.
  * Initializes enabled types, sets up explosion parameters, and binds health change events.
+ * On the server, also binds the physics wake and sleep events that drive the network dormancy, and registers the barrel
+ * for adaptive net update frequency.
+ * Enables the async physics tick if the barrel opted in and async physics is enabled in the project.
  */
 void AExplosiveBarrel::BeginPlay()
 {
@@ -128,11 +191,25 @@ void AExplosiveBarrel::BeginPlay()
 	{
 		AttributesComponent->OnHealthChanged.AddUniqueDynamic(this, &AExplosiveBarrel::HandleHealthChanged);
 	}
+
+	SetAsyncPhysicsTickEnabled(bUseAsyncPhysics && UPhysicsSettings::Get()->bTickPhysicsAsync);
+	if (HasAuthority() && IsValid(MeshComponent))
+	{
+		MeshComponent->OnComponentWake.AddUniqueDynamic(this, &AExplosiveBarrel::HandlePhysicsWake);
+		MeshComponent->OnComponentSleep.AddUniqueDynamic(this, &AExplosiveBarrel::HandlePhysicsSleep);
+		SetPhysicsAwake(MeshComponent->RigidBodyIsAwake());
+	}
+
+	UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+	if (HasAuthority() && IsValid(NetActivity))
+	{
+		NetActivity->RegisterActor(this);
+	}
 }
 
 /**
  * Called when the barrel is removed from the world.
- * Clears all timers associated with this barrel.
+ * Clears all timers associated with this barrel, stops counting it as awake and stops adapting its net update frequency.
  *
  * @param EndPlayReason The reason for removal.
  */
@@ -141,17 +218,30 @@ void AExplosiveBarrel::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 
 	GetWorldTimerManager().ClearAllTimersForObject(this);
+	SetPhysicsAwake(false);
+
+	UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+	if (IsValid(NetActivity))
+	{
+		NetActivity->UnregisterActor(this);
+	}
 }
 
 /**
  * Handles changes in the barrel's health.
- * Triggers explosion effects, applies radial damage to overlapping actors, and schedules barrel disappearance.
+ * Triggers explosion effects, and on the server queues the explosion in the explosion subsystem and schedules barrel disappearance.
+ * The server flushes the dormancy of the barrel first, so the health change reaches the clients even if it is at rest.
  *
  * @param HealthResult The new health value.
  * @param TotalHealth The maximum health value.
  */
 void AExplosiveBarrel::HandleHealthChanged(const float HealthResult, const float TotalHealth)
 {
+	if (HasAuthority())
+	{
+		FlushNetDormancy();
+	}
+
 	if (HealthResult > 0.0f)
 	{
 		return;
@@ -166,28 +256,20 @@ void AExplosiveBarrel::HandleHealthChanged(const float HealthResult, const float
 		ParticleComponent->ActivateSystem(true);
 	}
 
-	if (HasAuthority())
-	{
-		GetWorldTimerManager().SetTimer(DissapearTimerHandle, this, &AExplosiveBarrel::Multicast_HandleDissapear, DissapearTime, false);
-	}
-
-	if (!IsValid(ExplosionSphereComponent))
+	if (!HasAuthority())
 	{
 		return;
 	}
 
-	RadialDamageEvent.Origin = ExplosionSphereComponent->GetComponentLocation();
-	ExplosionSphereComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	ExplosionSphereComponent->GetOverlappingActors(ExplosionOverlaps);
-	for (AActor* A : ExplosionOverlaps)
+	SetNetDormancy(DORM_Awake);
+	GetWorldTimerManager().SetTimer(DissapearTimerHandle, this, &AExplosiveBarrel::Multicast_HandleDissapear, DissapearTime, false);
+
+	UExplosionSubsystem* ExplosionSubsystem = GetWorld()->GetSubsystem<UExplosionSubsystem>();
+	if (IsValid(ExplosionSphereComponent) && IsValid(ExplosionSubsystem))
 	{
-		if (A != this && IsValid(A))
-		{
-			A->TakeDamage(ImpulseMultiplier, RadialDamageEvent, GetInstigatorController(), this);
-		}
+		RadialDamageEvent.Origin = ExplosionSphereComponent->GetComponentLocation();
+		ExplosionSubsystem->QueueExplosion(this, RadialDamageEvent, ImpulseMultiplier, GetInstigatorController());
 	}
-
-	ExplosionSphereComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
 /**
@@ -197,4 +279,66 @@ void AExplosiveBarrel::HandleHealthChanged(const float HealthResult, const float
 void AExplosiveBarrel::Multicast_HandleDissapear_Implementation()
 {
 	Execute_OnTurnEnabled(this, false);
+	if (HasAuthority())
+	{
+		SetPhysicsAwake(false);
+	}
+}
+
+/**
+ * Handles the barrel body waking up on the server.
+ * Wakes the barrel network channel so its movement replicates again.
+ *
+ * @param WakingComponent The component whose body woke up.
+ * @param BoneName The bone of the body, unused by static meshes.
+ */
+void AExplosiveBarrel::HandlePhysicsWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	if (bEnableStatus)
+	{
+		SetPhysicsAwake(true);
+	}
+}
+
+/**
+ * Handles the barrel body going to sleep on the server.
+ * Sends the resting transform and puts the barrel network channel to sleep.
+ *
+ * @param SleepingComponent The component whose body went to sleep.
+ * @param BoneName The bone of the body, unused by static meshes.
+ */
+void AExplosiveBarrel::HandlePhysicsSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	SetPhysicsAwake(false);
+}
+
+/**
+ * Updates whether the barrel is awake, its network dormancy and the awake barrel count.
+ * A sleeping barrel forces a last update before going dormant, so the clients settle on the resting transform;
+ * the channel only closes once that update is acknowledged. Exploded barrels stay awake until they disappear.
+ *
+ * @param bAwake Whether the barrel body is awake.
+ */
+void AExplosiveBarrel::SetPhysicsAwake(const bool bAwake)
+{
+	if (bPhysicsAwake == bAwake)
+	{
+		return;
+	}
+
+	bPhysicsAwake = bAwake;
+	AwakeBarrelCount += bAwake ? 1 : -1;
+	if (bAwake)
+	{
+		INC_DWORD_STAT(STAT_AwakeBarrels);
+		SetNetDormancy(DORM_Awake);
+		return;
+	}
+
+	DEC_DWORD_STAT(STAT_AwakeBarrels);
+	ForceNetUpdate();
+	if (!GetWorldTimerManager().IsTimerActive(DissapearTimerHandle))
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
 }
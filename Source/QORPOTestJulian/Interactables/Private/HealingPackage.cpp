@@ -9,6 +9,7 @@
  */
 
 #include "../Public/HealingPackage.h"
+#include "../../QORPOTestJulian.h"
 
 /**
  * Called when another actor begins to overlap with this healing package.
@@ -20,6 +21,7 @@ void AHealingPackage::NotifyActorBeginOverlap(AActor* OtherActor)
 {
 	Super::NotifyActorBeginOverlap(OtherActor);
 
+	INC_DWORD_STAT(STAT_GameplayOverlapEvents);
 	Execute_OnInteract(this, OtherActor);
 }
 
@@ -18,6 +18,9 @@
  * Represents an interactable explosive barrel actor in the game world.
  * Handles damage processing, explosion effects, radial damage application, and networked state.
  * When destroyed, applies radial damage and impulse to nearby actors, plays visual and audio effects, and disables itself.
+ * At rest the barrel body sleeps early and the actor goes network dormant; it only replicates its movement, through
+ * predictive interpolation, while the physics body is awake.
+ * Optionally, with async physics enabled in the project, the rest detection runs on the fixed async physics step.
  * Designed to be extended in C++ or Blueprints for custom explosive behavior.
  */
 UCLASS(Blueprintable, BlueprintType)
@@ -31,8 +34,7 @@ public:
 
 	/**
 	 * Processes incoming damage events for this barrel.
-	 * Handles different types of damage events (point, radial, generic) and updates health accordingly.
-	 * Applies physics impulses on radial damage.
+	 * Queues generic, point and radial damage in the damage subsystem, which applies it in one batch per frame.
 	 *
 	 * @param DamageAmount The amount of damage.
 	 * @param DamageEvent The event describing the type of damage.
@@ -42,12 +44,27 @@ public:
 	 */
 	virtual float TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
+	/**
+	 * Called on the server before the barrel is replicated.
+	 * Reports the estimated movement bandwidth of the barrel while its body is awake.
+	 * @param ChangedPropertyTracker The tracker of the properties changed since the last replication.
+	 */
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/**
+	 * Called on the physics thread every fixed async physics step when the barrel uses async physics.
+	 * Puts the barrel body to sleep once it has rested long enough.
+	 * @param DeltaTime The fixed step duration.
+	 * @param SimTime The total simulated time.
+	 */
+	virtual void AsyncPhysicsTickActor(float DeltaTime, float SimTime) override;
+
 protected:
 	/** The static mesh component representing the barrel's visual appearance and physics. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UStaticMeshComponent* MeshComponent = nullptr;
 
-	/** Sphere component used to determine the explosion's area of effect. */
+	/** Sphere component defining the explosion's origin and radius; the explosion subsystem queries its area asynchronously. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USphereComponent* ExplosionSphereComponent = nullptr;
 
@@ -67,10 +84,6 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UAttributesComponent* AttributesComponent = nullptr;
 
-	/** List of actors affected by the explosion. */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Explosion")
-	TArray<AActor*> ExplosionOverlaps = TArray<AActor*>();
-
 	/** Timer handle used for managing barrel disappearance after explosion. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Explosion")
 	FTimerHandle DissapearTimerHandle = FTimerHandle();
@@ -83,7 +96,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Explosion")
 	FRadialDamageParams RadialDamageParameters = FRadialDamageParams(60.0f, 30.0f, 100.0f, 200.0f, 1.0f);
 
-	/** Multiplier for the impulse applied to affected actors during explosion. */
+	/** Multiplier of the explosion base damage giving the impulse applied to the bodies and pawns around. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Explosion", meta = (ClampMin = 0.0f, ClampMax = 100.0f))
 	float ImpulseMultiplier = 50.0f;
 
@@ -91,9 +104,33 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Explosion", meta = (ClampMin = 0.0f, ClampMax = 10.0f))
 	float DissapearTime = 4.0f;
 
+	/** Whether the barrel detects rest on the fixed async physics step, if async physics is enabled in the project. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Physics")
+	bool bUseAsyncPhysics = false;
+
+	/** Linear speed in cm/s below which the barrel body is considered at rest on the async physics step. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Physics", meta = (ClampMin = 0.0f, ClampMax = 100.0f))
+	float AsyncRestLinearSpeed = 5.0f;
+
+	/** Angular speed in rad/s below which the barrel body is considered at rest on the async physics step. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Physics", meta = (ClampMin = 0.0f, ClampMax = 10.0f))
+	float AsyncRestAngularSpeed = 0.2f;
+
+	/** Time in seconds the barrel body has to rest on the async physics step before it is put to sleep. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Physics", meta = (ClampMin = 0.0f, ClampMax = 5.0f))
+	float AsyncRestDelay = 0.25f;
+
+	/** Simulated time the barrel body has been resting, only accessed on the physics thread. */
+	float AsyncRestTime = 0.0f;
+
+	/** Whether the barrel body is awake, replicating its movement. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Physics")
+	bool bPhysicsAwake = false;
+
 	/**
 	 * Called when the game starts or when spawned.
 	 * Initializes enabled types, sets up explosion parameters, and binds health change events.
+	 * On the server, also binds the physics wake and sleep events that drive the network dormancy.
 	 */
 	virtual void BeginPlay() override;
 
@@ -106,7 +143,7 @@ protected:
 
 	/**
 	 * Handles changes in the barrel's health.
-	 * Triggers explosion effects, applies radial damage to overlapping actors, and schedules barrel disappearance.
+	 * Triggers explosion effects, and on the server queues the explosion and schedules barrel disappearance.
 	 *
 	 * @param HealthResult The new health value.
 	 * @param TotalHealth The maximum health value.
@@ -114,6 +151,32 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Interaction")
 	void HandleHealthChanged(const float HealthResult, const float TotalHealth);
 
+	/**
+	 * Handles the barrel body waking up on the server.
+	 * Wakes the barrel network channel so its movement replicates again.
+	 *
+	 * @param WakingComponent The component whose body woke up.
+	 * @param BoneName The bone of the body, unused by static meshes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Physics")
+	void HandlePhysicsWake(UPrimitiveComponent* WakingComponent, FName BoneName);
+
+	/**
+	 * Handles the barrel body going to sleep on the server.
+	 * Sends the resting transform and puts the barrel network channel to sleep.
+	 *
+	 * @param SleepingComponent The component whose body went to sleep.
+	 * @param BoneName The bone of the body, unused by static meshes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Physics")
+	void HandlePhysicsSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+	/**
+	 * Updates whether the barrel is awake, its network dormancy and the awake barrel count.
+	 * @param bAwake Whether the barrel body is awake.
+	 */
+	void SetPhysicsAwake(const bool bAwake);
+
 	/**
 	 * Multicast function to handle the barrel's disappearance after explosion.
 	 * Disables the barrel for all clients.
@@ -12,6 +12,9 @@
 
 #include "../Public/ReusableInterface.h"
 #include "../../Core/Public/ShooterPlayerController.h"
+#include "../../QORPOTestJulian.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Pooled Actors"), STAT_DormantPooledActors, STATGROUP_QORPOTestJulian);
 
 /**
  * Returns the original world position of the actor.
@@ -78,12 +81,27 @@ void IReusableInterface::SetOriginalRotation_Implementation(FRotator Rotation)
  * Enables or disables the actor and its components.
  * When enabled, resets the actor's position and rotation, shows the actor, enables ticking and collision.
  * When disabled, hides the actor, disables ticking and collision, and updates all registered primitive components.
+ * On the server, a disabled actor goes dormant for every connection once its hidden state is sent, and wakes up
+ * before its enabled state is changed, so pooled actors cost no replication while they wait to be reused.
+ * The transitions follow the actual network dormancy of the actor rather than bEnableStatus, which gameplay code
+ * may clear on its own, such as when an enemy is killed before being disabled.
  * @param bEnabled Whether the actor should be enabled.
  */
 void IReusableInterface::OnTurnEnabled_Implementation(const bool bEnabled)
 {
 	bEnableStatus = bEnabled;
 	AActor* Self = Cast<AActor>(this);
+	const bool bManagesDormancy = IsValid(Self) && Self->HasAuthority() && Self->GetIsReplicated();
+	if (bManagesDormancy && bEnabled)
+	{
+		WakePooledActor();
+		if (bPooledDormant)
+		{
+			bPooledDormant = false;
+			DEC_DWORD_STAT(STAT_DormantPooledActors);
+		}
+	}
+
 	if (IsValid(Self))
 	{
 		if (bEnabled)
@@ -108,6 +126,37 @@ void IReusableInterface::OnTurnEnabled_Implementation(const bool bEnabled)
 			P->UpdateOverlaps();
 		}
 	}
+
+	if (bManagesDormancy && !bEnabled && !bPooledDormant)
+	{
+		if (Self->NetDormancy == DORM_DormantAll)
+		{
+			Self->FlushNetDormancy();
+		}
+		else
+		{
+			Self->ForceNetUpdate();
+			Self->SetNetDormancy(DORM_DormantAll);
+		}
+
+		bPooledDormant = true;
+		INC_DWORD_STAT(STAT_DormantPooledActors);
+	}
+}
+
+/**
+ * Wakes the actor on the network if it went dormant while pooled, and forces an update so its channel reopens.
+ * Must be called on the server before sending a multicast to a pooled actor, since clients have no open channel
+ * for a dormant actor and its RPCs never reach them. Does nothing on clients or for awake actors.
+ */
+void IReusableInterface::WakePooledActor()
+{
+	AActor* Self = Cast<AActor>(this);
+	if (IsValid(Self) && Self->HasAuthority() && Self->GetIsReplicated() && Self->NetDormancy == DORM_DormantAll)
+	{
+		Self->SetNetDormancy(DORM_Awake);
+		Self->ForceNetUpdate();
+	}
 }
 
 /**
@@ -126,7 +175,7 @@ void IReusableInterface::AddEnabledType_Implementation(UPrimitiveComponent* Prim
 
 /**
  * Applies damage to a target actor using the networked damage system.
- * Calls the server-side damage function on the instigating player controller if available.
+ * Routes the damage through the instigating player controller if available, which applies it on the server.
  * @param DamageReceiver The actor receiving damage.
  * @param DamageAmount The amount of damage to apply.
  * @param DamageEvent The damage event struct.
@@ -142,6 +191,6 @@ void IReusableInterface::DoDamage_Implementation(AActor* DamageReceiver, float D
 	AShooterPlayerController* ShooterPlayerController = Self->GetInstigatorController<AShooterPlayerController>();
 	if (IsValid(ShooterPlayerController))
 	{
-		ShooterPlayerController->Server_DoDamage(DamageReceiver, DamageAmount, DamageEvent, ShooterPlayerController, Self);
+		ShooterPlayerController->DoDamage(DamageReceiver, DamageAmount, DamageEvent, Self);
 	}
 }
\ No newline at end of file
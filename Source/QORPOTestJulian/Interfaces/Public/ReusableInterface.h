@@ -76,6 +76,13 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Status")
 	void OnTurnEnabled(const bool bEnabled = true);
 
+	/**
+	 * Wakes the actor on the network if it went dormant while pooled.
+	 * Must be called on the server before sending a multicast to a pooled actor, since clients have no open channel
+	 * for a dormant actor and its RPCs never reach them.
+	 */
+	void WakePooledActor();
+
 protected:
 	/** Map of registered primitive components and their original collision states. */
 	TMap<UPrimitiveComponent*, TEnumAsByte<ECollisionEnabled::Type>> CollisionEnabledTypes = TMap<UPrimitiveComponent*, TEnumAsByte<ECollisionEnabled::Type>>();
@@ -89,6 +96,9 @@ protected:
 	/** Whether the actor is currently enabled/active. */
 	bool bEnableStatus = true;
 
+	/** Whether the actor was put to sleep on the network by being disabled, and is counted as a dormant pooled actor. */
+	bool bPooledDormant = false;
+
 	/**
 	 * Registers a primitive component for collision and visibility management.
 	 * Stores its original collision state for later restoration.
@@ -99,7 +109,7 @@ protected:
 
 	/**
 	 * Applies damage to a target actor using the networked damage system.
-	 * Calls the server-side damage function on the instigating player controller if available.
+	 * Routes the damage through the instigating player controller if available, which applies it on the server.
 	 * @param DamageReceiver The actor receiving damage.
 	 * @param DamageAmount The amount of damage to apply.
 	 * @param DamageEvent The damage event struct.
@@ -13,7 +13,10 @@ public class QORPOTestJulian : ModuleRules
 			"Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "AIModule", "NavigationSystem"
         });
 
-		PrivateDependencyModuleNames.AddRange(new string[] {  });
+		PrivateDependencyModuleNames.AddRange(new string[] { "FieldSystemEngine", "PhysicsCore", "Chaos", "ReplicationGraph", "NetCore" });
+
+		// Compiles Iris support in; Iris replication is switched on by net.Iris.UseIrisReplication in DefaultEngine.ini
+		SetupIrisSupport(Target);
 
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
@@ -3,4 +3,8 @@
 #include "QORPOTestJulian.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogQORPOTestJulian);
+
+DEFINE_STAT(STAT_GameplayOverlapEvents);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, QORPOTestJulian, "QORPOTestJulian" );
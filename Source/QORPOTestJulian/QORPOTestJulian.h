@@ -4,3 +4,26 @@
 
 #include "CoreMinimal.h"
 
+/** Stat group gathering the gameplay systems of the module (use "stat QORPOTestJulian" to display it). */
+DECLARE_STATS_GROUP(TEXT("QORPOTestJulian"), STATGROUP_QORPOTestJulian, STATCAT_Advanced);
+
+/** Log category of the gameplay systems of the module. */
+QORPOTESTJULIAN_API DECLARE_LOG_CATEGORY_EXTERN(LogQORPOTestJulian, Log, All);
+
+/** Number of actor overlap callbacks handled by gameplay code, to compare the overlap pairs the collision profiles let through. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gameplay Overlap Events"), STAT_GameplayOverlapEvents, STATGROUP_QORPOTestJulian, QORPOTESTJULIAN_API);
+
+/** Object channel of the enemy meshes (collision profile "EnemyHitVolume"), the enemy volume every weapon query and the lag compensation use. */
+#define ECC_Enemy ECC_GameTraceChannel1
+
+/** Object channel of the projectiles (collision profile "Projectile"). */
+#define ECC_Projectile ECC_GameTraceChannel2
+
+/** Object channel of the items picked up on overlap (collision profile "Pickup"). */
+#define ECC_Pickup ECC_GameTraceChannel3
+
+/** Object channel of the actors players interact with through traces (collision profile "Interactable"). */
+#define ECC_Interactable ECC_GameTraceChannel4
+
+/** Object channel of the enemy boxes blocking the world and players (collision profile "EnemyBlocker"), kept out of every weapon query. */
+#define ECC_EnemyBody ECC_GameTraceChannel5
@@ -0,0 +1,179 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file ContactDamageSubsystem.cpp
+ * @brief Implements the logic for the UContactDamageSubsystem class, which detects enemy contacts with the players in one pass.
+ *
+ * This subsystem replaces the overlap events of the enemy meshes: once per frame it tests the bounds of every active enemy
+ * against the capsules of the players, on every machine like the overlap events did, and lets each touching enemy
+ * deal its contact damage.
+ */
+
+#include "../Public/ContactDamageSubsystem.h"
+#include "../../QORPOTestJulian.h"
+#include "../../Characters/Public/BaseEnemy.h"
+
+DECLARE_CYCLE_STAT(TEXT("Contact Damage Pass"), STAT_ContactDamagePass, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact Tests"), STAT_ContactTests, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contacts"), STAT_Contacts, STATGROUP_QORPOTestJulian);
+
+/**
+ * Starts testing the contacts of an enemy.
+ * @param Enemy The enemy dealing contact damage.
+ */
+void UContactDamageSubsystem::RegisterEnemy(ABaseEnemy* Enemy)
+{
+	if (IsValid(Enemy))
+	{
+		Enemies.AddUnique(Enemy);
+	}
+}
+
+/**
+ * Stops testing the contacts of an enemy.
+ * @param Enemy The enemy to forget.
+ */
+void UContactDamageSubsystem::UnregisterEnemy(const ABaseEnemy* Enemy)
+{
+	Enemies.RemoveAllSwap([Enemy](const TWeakObjectPtr<ABaseEnemy>& E) { return E.Get() == Enemy; }, EAllowShrinking::No);
+}
+
+/**
+ * Starts testing the enemies against the capsule of an actor.
+ * @param Actor The actor damaged on contact.
+ * @param Capsule The upright capsule used as the contact volume of the actor.
+ */
+void UContactDamageSubsystem::RegisterTarget(AActor* Actor, UCapsuleComponent* Capsule)
+{
+	if (!IsValid(Actor) || !IsValid(Capsule) || Targets.ContainsByPredicate([Actor](const FContactTarget& T) { return T.Actor == Actor; }))
+	{
+		return;
+	}
+
+	FContactTarget& Target = Targets.AddDefaulted_GetRef();
+	Target.Actor = Actor;
+	Target.Capsule = Capsule;
+}
+
+/**
+ * Stops testing the enemies against an actor.
+ * @param Actor The actor to forget.
+ */
+void UContactDamageSubsystem::UnregisterTarget(const AActor* Actor)
+{
+	Targets.RemoveAllSwap([Actor](const FContactTarget& T) { return T.Actor.Get() == Actor; }, EAllowShrinking::No);
+}
+
+/**
+ * Tests every active enemy against every target and handles the contacts found.
+ * The target capsules are gathered once, then each enemy stops at its first contact, since handling it disables the enemy.
+ * Enemies and targets destroyed without unregistering are dropped along the way.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void UContactDamageSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_ContactDamagePass);
+
+	Capsules.Reset();
+	for (int i = Targets.Num() - 1; i >= 0; i--)
+	{
+		AActor* Actor = Targets[i].Actor.Get();
+		const UCapsuleComponent* Capsule = Targets[i].Capsule.Get();
+		if (!IsValid(Actor) || !IsValid(Capsule))
+		{
+			Targets.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+		else if (Actor->IsHidden() || !Capsule->IsCollisionEnabled())
+		{
+			continue;
+		}
+
+		FContactCapsule& Contact = Capsules.AddDefaulted_GetRef();
+		Contact.Actor = Actor;
+		Contact.Center = Capsule->GetComponentLocation();
+		Contact.HalfSegment = Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+		Contact.Radius = Capsule->GetScaledCapsuleRadius();
+	}
+
+	Contacts.Reset();
+	FBox Bounds = FBox(ForceInit);
+	for (int i = Enemies.Num() - 1; i >= 0 && !Capsules.IsEmpty(); i--)
+	{
+		ABaseEnemy* Enemy = Enemies[i].Get();
+		if (!IsValid(Enemy))
+		{
+			Enemies.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+		else if (!Enemy->GetContactBounds(Bounds))
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT_BY(STAT_ContactTests, Capsules.Num());
+		for (const FContactCapsule& Capsule : Capsules)
+		{
+			if (IsTouching(Bounds, Capsule))
+			{
+				Contacts.Emplace(Enemy, Capsule.Actor);
+				break;
+			}
+		}
+	}
+
+	for (const TPair<ABaseEnemy*, AActor*>& Contact : Contacts)
+	{
+		Contact.Key->HandleContact(Contact.Value);
+	}
+
+	INC_DWORD_STAT_BY(STAT_Contacts, Contacts.Num());
+}
+
+/**
+ * Returns whether there are both enemies and targets to test.
+ * @return True if a contact is possible.
+ */
+bool UContactDamageSubsystem::IsTickable() const
+{
+	return !Enemies.IsEmpty() && !Targets.IsEmpty();
+}
+
+/**
+ * Returns the stat used to profile the subsystem tick.
+ * @return The stat identifier.
+ */
+TStatId UContactDamageSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_ContactDamagePass);
+}
+
+/**
+ * Only creates the subsystem for game and PIE worlds.
+ * @param WorldType The type of the world the subsystem would be created for.
+ * @return True if the world type is supported.
+ */
+bool UContactDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * Returns whether a box touches an upright capsule.
+ * The closest points are found per axis: horizontally against the capsule axis, vertically against its segment,
+ * and the resulting distance is compared with the capsule radius.
+ * @param Bounds The world box to test.
+ * @param Capsule The capsule to test.
+ * @return True if the box and the capsule touch.
+ */
+bool UContactDamageSubsystem::IsTouching(const FBox& Bounds, const FContactCapsule& Capsule)
+{
+	const FVector& C = Capsule.Center;
+	const double DX = FMath::Max3(Bounds.Min.X - C.X, 0.0, C.X - Bounds.Max.X);
+	const double DY = FMath::Max3(Bounds.Min.Y - C.Y, 0.0, C.Y - Bounds.Max.Y);
+	const double DZ = FMath::Max3(Bounds.Min.Z - (C.Z + Capsule.HalfSegment), 0.0, (C.Z - Capsule.HalfSegment) - Bounds.Max.Z);
+
+	return DX * DX + DY * DY + DZ * DZ <= double(Capsule.Radius) * Capsule.Radius;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file DamageSubsystem.cpp
+ * @brief Implements the logic for the UDamageSubsystem class, which resolves the damage of a frame in one batched pass.
+ *
+ * This subsystem queues the damage events fed by the TakeDamage entry points, evaluates the radial falloff of all of them
+ * in a parallel pass, and applies the net health change of every receiver once per frame.
+ */
+
+#include "../Public/DamageSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "../../QORPOTestJulian.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Resolution"), STAT_DamageResolution, STATGROUP_QORPOTestJulian);
+DECLARE_CYCLE_STAT(TEXT("Damage Falloff"), STAT_DamageFalloff, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Resolved Damage Events"), STAT_ResolvedDamageEvents, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damaged Receivers"), STAT_DamagedReceivers, STATGROUP_QORPOTestJulian);
+
+/**
+ * Builds a queued damage event from a generic, point or radial damage event.
+ * Flat damage is always negative; radial damage starts from its base damage and is scaled by the falloff later.
+ * Receivers apply their amount modifiers afterwards.
+ * @param Receiver The actor receiving the damage.
+ * @param Attributes The attributes of the receiver.
+ * @param DamageAmount The amount of flat damage (unused by radial damage).
+ * @param DamageEvent The event describing the type of damage.
+ * @param Instigator The controller responsible for the damage.
+ * @return The queued damage, without attributes if the event type is not queued.
+ */
+FQueuedDamage UDamageSubsystem::MakeQueuedDamage(const AActor* Receiver, UAttributesComponent* Attributes, const float DamageAmount, FDamageEvent const& DamageEvent, AController* Instigator)
+{
+	FQueuedDamage Damage = FQueuedDamage();
+	Damage.Instigator = Instigator;
+	Damage.Position = IsValid(Receiver) ? Receiver->GetActorLocation() : FVector::ZeroVector;
+	switch (DamageEvent.GetTypeID())
+	{
+	case FDamageEvent::ClassID:
+	case FPointDamageEvent::ClassID:
+	{
+		Damage.Attributes = Attributes;
+		Damage.Amount = -abs(DamageAmount);
+		break;
+	}
+	case FRadialDamageEvent::ClassID:
+	{
+		const FRadialDamageEvent& RadialEvent = static_cast<const FRadialDamageEvent&>(DamageEvent);
+		Damage.Attributes = Attributes;
+		Damage.RadialParams = RadialEvent.Params;
+		Damage.Origin = RadialEvent.Origin;
+		Damage.Amount = RadialEvent.Params.BaseDamage;
+		Damage.bRadial = true;
+		break;
+	}
+	default:
+		break;
+	}
+
+	return Damage;
+}
+
+/**
+ * Queues a damage event until the end of the frame.
+ * @param Damage The damage to queue.
+ * @return The flat health change queued, or zero for radial damage (resolved with the batch).
+ */
+float UDamageSubsystem::QueueDamage(const FQueuedDamage& Damage)
+{
+	if (!Damage.Attributes.IsValid())
+	{
+		return 0.0f;
+	}
+
+	Queue.Add(Damage);
+
+	return Damage.bRadial ? 0.0f : Damage.Amount;
+}
+
+/**
+ * Returns the number of damage events waiting for the next pass.
+ * @return The queued damage count.
+ */
+const int UDamageSubsystem::GetQueuedDamageCount() const
+{
+	return Queue.Num();
+}
+
+/**
+ * Resolves every queued damage event in one batched pass.
+ * The radial falloff of every event is evaluated in parallel from plain values, then the health changes are summed per
+ * receiver and applied once, crediting the last instigator of the frame. Damage caused while applying (e.g., chained
+ * explosions) is queued for the next pass.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void UDamageSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_DamageResolution);
+
+	Swap(Queue, Resolving);
+	Queue.Reset();
+	Deltas.SetNumUninitialized(Resolving.Num(), EAllowShrinking::No);
+	{
+		SCOPE_CYCLE_COUNTER(STAT_DamageFalloff);
+
+		ParallelFor(Resolving.Num(), [this](const int Index)
+			{
+				const FQueuedDamage& Damage = Resolving[Index];
+				Deltas[Index] = Damage.bRadial
+					? -abs(Damage.Amount * Damage.RadialParams.GetDamageScale(FVector::Distance(Damage.Position, Damage.Origin)))
+					: Damage.Amount;
+			}, Resolving.Num() < ParallelBatchThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	Totals.Reset();
+	TotalIndices.Reset();
+	for (int i = 0; i < Resolving.Num(); i++)
+	{
+		const FQueuedDamage& Damage = Resolving[i];
+		const int* TotalIndex = TotalIndices.Find(Damage.Attributes.Get());
+		FDamageReceiverTotal& Total = TotalIndex != nullptr ? Totals[*TotalIndex] : Totals.AddDefaulted_GetRef();
+		if (TotalIndex == nullptr)
+		{
+			TotalIndices.Add(Damage.Attributes.Get(), Totals.Num() - 1);
+			Total.Attributes = Damage.Attributes;
+		}
+
+		Total.Amount += Deltas[i];
+		Total.Instigator = Damage.Instigator.IsValid() ? Damage.Instigator : Total.Instigator;
+	}
+
+	for (const FDamageReceiverTotal& Total : Totals)
+	{
+		UAttributesComponent* Attributes = Total.Attributes.Get();
+		if (IsValid(Attributes))
+		{
+			Attributes->ApplyDamage(Total.Amount, Total.Instigator.Get());
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_ResolvedDamageEvents, Resolving.Num());
+	INC_DWORD_STAT_BY(STAT_DamagedReceivers, Totals.Num());
+	Resolving.Reset();
+}
+
+/**
+ * Returns whether there is any damage to resolve.
+ * @return True if any damage is queued.
+ */
+bool UDamageSubsystem::IsTickable() const
+{
+	return !Queue.IsEmpty();
+}
+
+/**
+ * Returns the stat used to profile the subsystem tick.
+ * @return The stat identifier.
+ */
+TStatId UDamageSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_DamageResolution);
+}
+
+/**
+ * Only creates the subsystem for game and PIE worlds.
+ * @param WorldType The type of the world the subsystem would be created for.
+ * @return True if the world type is supported.
+ */
+bool UDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
\ No newline at end of file
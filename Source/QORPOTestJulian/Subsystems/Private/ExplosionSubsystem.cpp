@@ -0,0 +1,281 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file ExplosionSubsystem.cpp
+ * @brief Implements the logic for the UExplosionSubsystem class, which resolves explosions through budgeted asynchronous overlaps.
+ *
+ * This subsystem starts a bounded number of explosions per frame by issuing asynchronous sphere overlap queries,
+ * and deals their radial damage when the results arrive the following frame. Since damage is queued in the damage subsystem,
+ * chain reactions advance one link per frame and never recurse. Physics bodies are pushed by one transient Chaos field
+ * per explosion, and pawns by a single knockback per frame accumulated from every explosion that reached them.
+ */
+
+#include "../Public/ExplosionSubsystem.h"
+#include "Engine/OverlapResult.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Field/FieldSystemComponent.h"
+#include "Field/FieldSystemObjects.h"
+#include "../../QORPOTestJulian.h"
+
+DECLARE_CYCLE_STAT(TEXT("Explosion Resolution"), STAT_ExplosionResolution, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Explosions"), STAT_QueuedExplosions, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Resolved Explosions"), STAT_ResolvedExplosions, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Overlaps"), STAT_ExplosionOverlaps, STATGROUP_QORPOTestJulian);
+DECLARE_CYCLE_STAT(TEXT("Explosion Field Emission"), STAT_ExplosionFieldEmission, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Fields"), STAT_ExplosionFields, STATGROUP_QORPOTestJulian);
+DECLARE_CYCLE_STAT(TEXT("Explosion Knockback"), STAT_ExplosionKnockback, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Knocked Back Pawns"), STAT_KnockedBackPawns, STATGROUP_QORPOTestJulian);
+
+/**
+ * Default constructor.
+ * Adds the enemy meshes to the dynamic object types the explosions can affect.
+ */
+UExplosionSubsystem::UExplosionSubsystem()
+{
+	ObjectParams.AddObjectTypesToQuery(ECC_Enemy);
+}
+
+/**
+ * Queues an explosion to be resolved once the per-frame budget allows it.
+ * @param Causer The actor exploding.
+ * @param DamageEvent The radial damage of the explosion, including its origin and radii.
+ * @param ImpulseStrength The multiplier of the base damage giving the impulse of the explosion.
+ * @param Instigator The controller responsible for the explosion.
+ */
+void UExplosionSubsystem::QueueExplosion(AActor* Causer, const FRadialDamageEvent& DamageEvent, const float ImpulseStrength, AController* Instigator)
+{
+	FPendingExplosion& Explosion = Queue.AddDefaulted_GetRef();
+	Explosion.DamageEvent = DamageEvent;
+	Explosion.ImpulseStrength = ImpulseStrength;
+	Explosion.Causer = Causer;
+	Explosion.Instigator = Instigator;
+}
+
+/**
+ * Returns the number of explosions queued or waiting for their overlap query.
+ * @return The pending explosion count.
+ */
+const int UExplosionSubsystem::GetPendingExplosionCount() const
+{
+	return Queue.Num() + InFlight.Num();
+}
+
+/**
+ * Resolves the overlap queries issued on the previous frame, applies the knockback they caused, and starts the queued
+ * explosions within budget. A query whose result expired without being read falls back to a synchronous overlap,
+ * so no explosion is lost.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void UExplosionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_ExplosionResolution);
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	FOverlapDatum OverlapDatum = FOverlapDatum();
+	TArray<FOverlapResult> Overlaps = TArray<FOverlapResult>();
+	for (int i = InFlight.Num() - 1; i >= 0; i--)
+	{
+		const FPendingExplosion& Explosion = InFlight[i];
+		if (World->QueryOverlapData(Explosion.OverlapHandle, OverlapDatum))
+		{
+			ApplyExplosion(Explosion, OverlapDatum.OutOverlaps);
+		}
+		else if (GFrameCounter > Explosion.QueryFrame + 1)
+		{
+			Overlaps.Reset();
+			World->OverlapMultiByObjectType(Overlaps, Explosion.DamageEvent.Origin, FQuat::Identity, ObjectParams,
+				FCollisionShape::MakeSphere(Explosion.DamageEvent.Params.GetMaxRadius()), FCollisionQueryParams(NAME_None, false, Explosion.Causer.Get()));
+			ApplyExplosion(Explosion, Overlaps);
+		}
+		else
+		{
+			continue;
+		}
+
+		InFlight.RemoveAtSwap(i, 1, EAllowShrinking::No);
+	}
+
+	ApplyKnockbacks();
+
+	const int Started = FMath::Min(Queue.Num(), MaxExplosionsPerFrame);
+	for (int i = 0; i < Started; i++)
+	{
+		FPendingExplosion& Explosion = InFlight.Add_GetRef(Queue[i]);
+		Explosion.QueryFrame = GFrameCounter;
+		Explosion.OverlapHandle = World->AsyncOverlapByObjectType(Explosion.DamageEvent.Origin, FQuat::Identity, ObjectParams,
+			FCollisionShape::MakeSphere(Explosion.DamageEvent.Params.GetMaxRadius()), FCollisionQueryParams(NAME_None, false, Explosion.Causer.Get()));
+	}
+
+	Queue.RemoveAt(0, Started, EAllowShrinking::No);
+	SET_DWORD_STAT(STAT_QueuedExplosions, Queue.Num());
+}
+
+/**
+ * Returns whether there is any explosion to start or resolve.
+ * @return True if any explosion is pending.
+ */
+bool UExplosionSubsystem::IsTickable() const
+{
+	return !Queue.IsEmpty() || !InFlight.IsEmpty();
+}
+
+/**
+ * Returns the stat used to profile the subsystem tick.
+ * @return The stat identifier.
+ */
+TStatId UExplosionSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_ExplosionResolution);
+}
+
+/**
+ * Only creates the subsystem for game and PIE worlds.
+ * @param WorldType The type of the world the subsystem would be created for.
+ * @return True if the world type is supported.
+ */
+bool UExplosionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * Deals the damage of an explosion to every actor it overlaps, once per actor, and pushes them.
+ * The damage is queued by the receivers, so barrels detonated by it explode on a later frame.
+ * Physics bodies are pushed by the explosion field, pawns by their accumulated knockback.
+ * @param Explosion The explosion to apply.
+ * @param Overlaps The overlaps of the explosion sphere.
+ */
+void UExplosionSubsystem::ApplyExplosion(const FPendingExplosion& Explosion, const TArray<FOverlapResult>& Overlaps)
+{
+	AActor* Causer = Explosion.Causer.Get();
+	AffectedActors.Reset();
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* Actor = Overlap.GetActor();
+		if (IsValid(Actor) && Actor != Causer)
+		{
+			AffectedActors.AddUnique(Actor);
+		}
+	}
+
+	for (AActor* A : AffectedActors)
+	{
+		A->TakeDamage(Explosion.ImpulseStrength, Explosion.DamageEvent, Explosion.Instigator.Get(), Causer);
+		APawn* Pawn = Cast<APawn>(A);
+		if (IsValid(Pawn))
+		{
+			AddKnockback(Pawn, Explosion);
+		}
+	}
+
+	if (bUsePhysicsFields)
+	{
+		EmitImpulseField(Explosion);
+	}
+
+	INC_DWORD_STAT(STAT_ResolvedExplosions);
+	INC_DWORD_STAT_BY(STAT_ExplosionOverlaps, AffectedActors.Num());
+}
+
+/**
+ * Emits a transient radial impulse field for an explosion, creating the field component if needed.
+ * The field nodes are reused: applying a field builds its own evaluation graph, so they can be reconfigured right away.
+ * The impulse fades linearly from the origin to the explosion radius, with the base damage times the impulse strength at its peak.
+ * @param Explosion The exploding explosion.
+ */
+void UExplosionSubsystem::EmitImpulseField(const FPendingExplosion& Explosion)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ExplosionFieldEmission);
+
+	UWorld* World = GetWorld();
+	if (!IsValid(FieldComponent))
+	{
+		FActorSpawnParameters SpawnParameters = FActorSpawnParameters();
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		FieldActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+		FieldComponent = NewObject<UFieldSystemComponent>(FieldActor);
+		FieldComponent->RegisterComponent();
+		FieldActor->AddInstanceComponent(FieldComponent);
+		FieldFalloff = NewObject<URadialFalloff>(FieldComponent);
+		FieldDirection = NewObject<URadialVector>(FieldComponent);
+		FieldOperator = NewObject<UOperatorField>(FieldComponent);
+	}
+
+	const FRadialDamageEvent& DamageEvent = Explosion.DamageEvent;
+	const float Magnitude = abs(DamageEvent.Params.BaseDamage) * Explosion.ImpulseStrength;
+	FieldFalloff->SetRadialFalloff(Magnitude, 0.0f, 1.0f, 0.0f, DamageEvent.Params.GetMaxRadius(), DamageEvent.Origin, EFieldFalloffType::Field_FallOff_Linear);
+	FieldDirection->SetRadialVector(1.0f, DamageEvent.Origin);
+	FieldOperator->SetOperatorField(1.0f, FieldFalloff, FieldDirection, EFieldOperationType::Field_Multiply);
+	FieldComponent->ApplyPhysicsField(true, EFieldPhysicsType::Field_LinearImpulse, nullptr, FieldOperator);
+
+	INC_DWORD_STAT(STAT_ExplosionFields);
+}
+
+/**
+ * Accumulates the knockback of an explosion on a pawn.
+ * The velocity change points away from the origin, scaled by the damage the pawn receives times the impulse strength
+ * and fading linearly to the explosion radius.
+ * @param Pawn The pawn reached by the explosion.
+ * @param Explosion The explosion pushing the pawn.
+ */
+void UExplosionSubsystem::AddKnockback(APawn* Pawn, const FPendingExplosion& Explosion)
+{
+	UMovementComponent* Movement = Pawn->GetMovementComponent();
+	if (!IsValid(Movement))
+	{
+		return;
+	}
+
+	const FRadialDamageParams& Params = Explosion.DamageEvent.Params;
+	const FVector Offset = Pawn->GetActorLocation() - Explosion.DamageEvent.Origin;
+	const float Distance = Offset.Size();
+	const float Radius = Params.GetMaxRadius();
+	const float Falloff = Radius > 0.0f ? FMath::Max(1.0f - Distance / Radius, 0.0f) : 0.0f;
+	const float Strength = abs(Params.BaseDamage * Params.GetDamageScale(Distance)) * Explosion.ImpulseStrength * Falloff;
+
+	const int* KnockbackIndex = KnockbackIndices.Find(Movement);
+	FPawnKnockback& Knockback = KnockbackIndex != nullptr ? Knockbacks[*KnockbackIndex] : Knockbacks.AddDefaulted_GetRef();
+	if (KnockbackIndex == nullptr)
+	{
+		KnockbackIndices.Add(Movement, Knockbacks.Num() - 1);
+		Knockback.Movement = Movement;
+	}
+
+	Knockback.VelocityChange += Offset.GetSafeNormal() * Strength;
+}
+
+/**
+ * Applies the knockback accumulated by every pawn during the frame, once per pawn.
+ * Characters receive it as a velocity change impulse so their movement mode reacts (e.g., launched off the ground);
+ * other pawns have it added to their velocity.
+ */
+void UExplosionSubsystem::ApplyKnockbacks()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ExplosionKnockback);
+
+	for (const FPawnKnockback& Knockback : Knockbacks)
+	{
+		UMovementComponent* Movement = Knockback.Movement.Get();
+		UCharacterMovementComponent* CharacterMovement = Cast<UCharacterMovementComponent>(Movement);
+		if (IsValid(CharacterMovement))
+		{
+			CharacterMovement->AddImpulse(Knockback.VelocityChange, true);
+		}
+		else if (IsValid(Movement))
+		{
+			Movement->Velocity += Knockback.VelocityChange;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_KnockedBackPawns, Knockbacks.Num());
+	Knockbacks.Reset();
+	KnockbackIndices.Reset();
+}
\ No newline at end of file
@@ -0,0 +1,348 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file LagCompensationSubsystem.cpp
+ * @brief Implements the logic for the ULagCompensationSubsystem class, which rewinds enemy and player hit volumes for hit-scan shots.
+ *
+ * This subsystem records the world bounds of the registered actors in a ring buffer of structure of arrays snapshots on the server,
+ * and tests shot lines against the volumes interpolated at the shooter's view time, four volumes at a time with vector registers.
+ */
+
+#include "../Public/LagCompensationSubsystem.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/Controller.h"
+#include "../../QORPOTestJulian.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lag Compensation Record"), STAT_LagCompensationRecord, STATGROUP_QORPOTestJulian);
+DECLARE_CYCLE_STAT(TEXT("Lag Compensation Rewind"), STAT_LagCompensationRewind, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lag Compensated Volumes"), STAT_LagCompensatedVolumes, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Lag Compensation Rejected Volumes"), STAT_LagCompensationRejectedVolumes, STATGROUP_QORPOTestJulian);
+DECLARE_MEMORY_STAT(TEXT("Lag Compensation History"), STAT_LagCompensationMemory, STATGROUP_QORPOTestJulian);
+
+/** Center given to unused slots, far enough for no shot line to ever reach it. */
+static constexpr float UnreachableCenter = 1.0e10f;
+
+/**
+ * Allocates the snapshot history from the configured limits.
+ * The slot count is rounded up to the vector width so the rewind never needs a scalar tail.
+ * @param Collection The collection of subsystems being initialized.
+ */
+void ULagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SlotStride = Align(FMath::Max(MaxTrackedActors, 4), 4);
+	const int HistorySize = HistoryFrames * SlotStride;
+	FrameTimes.Init(TNumericLimits<float>::Lowest(), HistoryFrames);
+	CentersX.Init(UnreachableCenter, HistorySize);
+	CentersY.Init(UnreachableCenter, HistorySize);
+	CentersZ.Init(UnreachableCenter, HistorySize);
+	ExtentsX.Init(0.0f, HistorySize);
+	ExtentsY.Init(0.0f, HistorySize);
+	ExtentsZ.Init(0.0f, HistorySize);
+	SlotActors.SetNum(SlotStride);
+	SlotVolumes.SetNum(SlotStride);
+
+	SET_MEMORY_STAT(STAT_LagCompensationMemory, HistorySize * 6 * sizeof(float) + HistoryFrames * sizeof(float));
+}
+
+/**
+ * Starts recording the hit volume of an actor, filling its whole history with the current bounds
+ * so a reused slot never rewinds to the volume of its previous actor.
+ * The first ReservedPlayerSlots slots can only be taken by reserved registrations, so players always find a slot however
+ * many enemies are active. A registration finding no free slot is rejected, counted and reported once in the log.
+ * @param Actor The actor to rewind.
+ * @param Volume The component whose world bounds are used as the actor's hit volume.
+ * @param bReservedSlot Whether the volume can use the slots reserved for players.
+ */
+void ULagCompensationSubsystem::RegisterHitVolume(AActor* Actor, UPrimitiveComponent* Volume, const bool bReservedSlot)
+{
+	if (!IsValid(Actor) || !IsValid(Volume) || SlotIndices.Contains(Actor))
+	{
+		return;
+	}
+
+	int Slot = bReservedSlot ? 0 : FMath::Min(ReservedPlayerSlots, MaxTrackedActors);
+	while (Slot < MaxTrackedActors && SlotActors[Slot].IsValid())
+	{
+		Slot++;
+	}
+
+	if (Slot >= MaxTrackedActors)
+	{
+		INC_DWORD_STAT(STAT_LagCompensationRejectedVolumes);
+		if (!bReportedFullHistory)
+		{
+			bReportedFullHistory = true;
+			UE_LOG(LogQORPOTestJulian, Warning, TEXT("Lag compensation has no free slot for %s (MaxTrackedActors %d, ReservedPlayerSlots %d); its hits will not be rewound."),
+				*Actor->GetName(), MaxTrackedActors, ReservedPlayerSlots);
+		}
+
+		return;
+	}
+
+	SlotActors[Slot] = Actor;
+	SlotVolumes[Slot] = Volume;
+	SlotIndices.Add(Actor, Slot);
+	for (int Frame = 0; Frame < HistoryFrames; Frame++)
+	{
+		RecordSlot(Frame, Slot);
+	}
+}
+
+/**
+ * Stops recording the hit volume of an actor and clears its slot in every snapshot.
+ * @param Actor The actor to forget.
+ */
+void ULagCompensationSubsystem::UnregisterHitVolume(const AActor* Actor)
+{
+	int Slot = INDEX_NONE;
+	if (!SlotIndices.RemoveAndCopyValue(Actor, Slot))
+	{
+		return;
+	}
+
+	SlotActors[Slot] = nullptr;
+	SlotVolumes[Slot] = nullptr;
+	for (int Frame = 0; Frame < HistoryFrames; Frame++)
+	{
+		RecordSlot(Frame, Slot);
+	}
+}
+
+/**
+ * Returns whether the hit volume of an actor is recorded.
+ * @param Actor The actor to check.
+ * @return True if hits against the actor should be resolved through the history.
+ */
+const bool ULagCompensationSubsystem::IsTracked(const AActor* Actor) const
+{
+	return SlotIndices.Contains(Actor);
+}
+
+/**
+ * Returns whether shots of the given controller should be resolved against the rewound history.
+ * Only remote players on the server are compensated; local shots already see current positions.
+ * @param Controller The controller of the shooter.
+ * @return True if the shot should be rewound.
+ */
+const bool ULagCompensationSubsystem::ShouldRewind(const AController* Controller) const
+{
+	const UWorld* World = GetWorld();
+	return bEnableLagCompensation && RecordedFrames > 0 && IsValid(World) && World->GetNetMode() != NM_Client
+		&& IsValid(Controller) && Controller->IsPlayerController() && !Controller->IsLocalController();
+}
+
+/**
+ * Sets the time clients render the interpolated enemies behind their last received sample, keeping the longest one
+ * reported by the enemy movement proxies.
+ * @param Delay The interpolation delay in seconds.
+ */
+void ULagCompensationSubsystem::SetInterpolationDelay(const float Delay)
+{
+	InterpolationDelay = FMath::Max(InterpolationDelay, Delay);
+}
+
+/**
+ * Returns the server time the given shooter was seeing when firing, clamped to the recorded window.
+ * The shooter saw the targets one trip ago and its shot took another trip to arrive, so the whole round trip is rewound,
+ * and the enemies were drawn a further interpolation delay behind their latest samples. Both add up before the clamp,
+ * so the rewind never leaves the recorded window.
+ * @param Controller The controller of the shooter.
+ * @return The world time to rewind to.
+ */
+const float ULagCompensationSubsystem::GetViewTime(const AController* Controller) const
+{
+	const UWorld* World = GetWorld();
+	const float Now = IsValid(World) ? World->GetTimeSeconds() : 0.0f;
+	const APlayerState* PlayerState = IsValid(Controller) ? Controller->GetPlayerState<APlayerState>() : nullptr;
+	const float RoundTrip = IsValid(PlayerState) ? PlayerState->GetPingInMilliseconds() * 0.001f : 0.0f;
+
+	return Now - FMath::Clamp(RoundTrip + InterpolationDelay, 0.0f, MaxRewindTime);
+}
+
+/**
+ * Returns the maximum time in seconds a shot can be rewound.
+ * @return The rewind window.
+ */
+const float ULagCompensationSubsystem::GetMaxRewindTime() const
+{
+	return MaxRewindTime;
+}
+
+/**
+ * Tests a line against every hit volume as it was at the given time.
+ * The snapshots bracketing the time are interpolated and slab tested four slots at a time: the entry and exit fractions
+ * of the line are computed per axis for the four volumes at once, and only the lanes that report a hit are read back.
+ * @param Start The start of the line.
+ * @param End The end of the line.
+ * @param Time The world time to rewind to.
+ * @param IgnoredActor Actor whose volume is skipped (usually the shooter).
+ * @param OutHit Set to the closest volume crossed by the line.
+ * @return True if any volume is crossed.
+ */
+bool ULagCompensationSubsystem::RewindLineTrace(const FVector& Start, const FVector& End, const float Time, const AActor* IgnoredActor, FRewoundHit& OutHit) const
+{
+	if (RecordedFrames <= 0)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationRewind);
+
+	int NewerFrame = NewestFrame;
+	int OlderFrame = NewestFrame;
+	for (int i = 1; i < RecordedFrames && FrameTimes[OlderFrame] > Time; i++)
+	{
+		NewerFrame = OlderFrame;
+		OlderFrame = (OlderFrame - 1 + HistoryFrames) % HistoryFrames;
+	}
+
+	const float FrameSpan = FrameTimes[NewerFrame] - FrameTimes[OlderFrame];
+	const float Alpha = FrameSpan > 0.0f ? FMath::Clamp((Time - FrameTimes[OlderFrame]) / FrameSpan, 0.0f, 1.0f) : 0.0f;
+	const int Older = OlderFrame * SlotStride;
+	const int Newer = NewerFrame * SlotStride;
+
+	const FVector Delta = End - Start;
+	const auto SafeInverse = [](const double Value) { return 1.0f / float(FMath::Abs(Value) > KINDA_SMALL_NUMBER ? Value : (Value < 0.0 ? -KINDA_SMALL_NUMBER : KINDA_SMALL_NUMBER)); };
+	const VectorRegister4Float StartX = VectorSetFloat1(float(Start.X));
+	const VectorRegister4Float StartY = VectorSetFloat1(float(Start.Y));
+	const VectorRegister4Float StartZ = VectorSetFloat1(float(Start.Z));
+	const VectorRegister4Float InverseX = VectorSetFloat1(SafeInverse(Delta.X));
+	const VectorRegister4Float InverseY = VectorSetFloat1(SafeInverse(Delta.Y));
+	const VectorRegister4Float InverseZ = VectorSetFloat1(SafeInverse(Delta.Z));
+	const VectorRegister4Float Blend = VectorSetFloat1(Alpha);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+
+	const auto Rewind = [Blend](const TArray<float>& Values, const int OlderIndex, const int NewerIndex)
+	{
+		const VectorRegister4Float OlderValue = VectorLoad(&Values[OlderIndex]);
+		return VectorMultiplyAdd(VectorSubtract(VectorLoad(&Values[NewerIndex]), OlderValue), Blend, OlderValue);
+	};
+	const auto Slab = [](const VectorRegister4Float& Center, const VectorRegister4Float& Extent, const VectorRegister4Float& Origin,
+		const VectorRegister4Float& Inverse, VectorRegister4Float& Entry, VectorRegister4Float& Exit)
+	{
+		const VectorRegister4Float Near = VectorMultiply(VectorSubtract(VectorSubtract(Center, Extent), Origin), Inverse);
+		const VectorRegister4Float Far = VectorMultiply(VectorSubtract(VectorAdd(Center, Extent), Origin), Inverse);
+		Entry = VectorMax(Entry, VectorMin(Near, Far));
+		Exit = VectorMin(Exit, VectorMax(Near, Far));
+	};
+
+	bool bHit = false;
+	OutHit.Time = 1.0f;
+	for (int Slot = 0; Slot < SlotStride; Slot += 4)
+	{
+		VectorRegister4Float Entry = Zero;
+		VectorRegister4Float Exit = One;
+		Slab(Rewind(CentersX, Older + Slot, Newer + Slot), Rewind(ExtentsX, Older + Slot, Newer + Slot), StartX, InverseX, Entry, Exit);
+		Slab(Rewind(CentersY, Older + Slot, Newer + Slot), Rewind(ExtentsY, Older + Slot, Newer + Slot), StartY, InverseY, Entry, Exit);
+		Slab(Rewind(CentersZ, Older + Slot, Newer + Slot), Rewind(ExtentsZ, Older + Slot, Newer + Slot), StartZ, InverseZ, Entry, Exit);
+
+		const int HitMask = VectorMaskBits(VectorCompareLE(Entry, Exit));
+		if (HitMask == 0)
+		{
+			continue;
+		}
+
+		float Entries[4];
+		VectorStore(Entry, Entries);
+		for (int Lane = 0; Lane < 4; Lane++)
+		{
+			AActor* Actor = SlotActors[Slot + Lane].Get();
+			if ((HitMask & (1 << Lane)) != 0 && Entries[Lane] < OutHit.Time && IsValid(Actor) && Actor != IgnoredActor)
+			{
+				bHit = true;
+				OutHit.Actor = Actor;
+				OutHit.Time = Entries[Lane];
+			}
+		}
+	}
+
+	if (bHit)
+	{
+		OutHit.Location = Start + Delta * OutHit.Time;
+	}
+
+	return bHit;
+}
+
+/**
+ * Records a snapshot of every hit volume when the snapshot interval has elapsed.
+ * Snapshots are spaced by MaxRewindTime / HistoryFrames, so the ring buffer always spans the rewind window.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UWorld* World = GetWorld();
+	const float Now = World->GetTimeSeconds();
+	if (RecordedFrames > 0 && Now - FrameTimes[NewestFrame] < MaxRewindTime / HistoryFrames)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationRecord);
+
+	NewestFrame = (NewestFrame + 1) % HistoryFrames;
+	RecordedFrames = FMath::Min(RecordedFrames + 1, HistoryFrames);
+	FrameTimes[NewestFrame] = Now;
+	for (int Slot = 0; Slot < SlotStride; Slot++)
+	{
+		RecordSlot(NewestFrame, Slot);
+	}
+
+	SET_DWORD_STAT(STAT_LagCompensatedVolumes, SlotIndices.Num());
+}
+
+/**
+ * Returns whether there is any hit volume to record on the server.
+ * @return True if the subsystem has volumes to record and is not running on a client.
+ */
+bool ULagCompensationSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return bEnableLagCompensation && !SlotIndices.IsEmpty() && IsValid(World) && World->GetNetMode() != NM_Client;
+}
+
+/**
+ * Returns the stat used to profile the subsystem tick.
+ * @return The stat identifier.
+ */
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_LagCompensationRecord);
+}
+
+/**
+ * Only creates the subsystem for game and PIE worlds.
+ * @param WorldType The type of the world the subsystem would be created for.
+ * @return True if the world type is supported.
+ */
+bool ULagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * Writes the current bounds of a slot into a snapshot, or an unreachable empty volume if the slot is unused
+ * or its actor is hidden (e.g., pooled enemies waiting to respawn).
+ * @param Frame The snapshot to write.
+ * @param Slot The slot to record.
+ */
+void ULagCompensationSubsystem::RecordSlot(const int Frame, const int Slot)
+{
+	const int Index = Frame * SlotStride + Slot;
+	const AActor* Actor = SlotActors[Slot].Get();
+	const UPrimitiveComponent* Volume = SlotVolumes[Slot].Get();
+	const bool bRecorded = IsValid(Actor) && IsValid(Volume) && !Actor->IsHidden();
+	const FVector Center = bRecorded ? Volume->Bounds.Origin : FVector(UnreachableCenter);
+	const FVector Extent = bRecorded ? Volume->Bounds.BoxExtent : FVector::ZeroVector;
+	CentersX[Index] = float(Center.X);
+	CentersY[Index] = float(Center.Y);
+	CentersZ[Index] = float(Center.Z);
+	ExtentsX[Index] = float(Extent.X);
+	ExtentsY[Index] = float(Extent.Y);
+	ExtentsZ[Index] = float(Extent.Z);
+}
\ No newline at end of file
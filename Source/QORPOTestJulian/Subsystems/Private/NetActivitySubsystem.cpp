@@ -0,0 +1,256 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file NetActivitySubsystem.cpp
+ * @brief Implements the logic for the UNetActivitySubsystem class, which adapts the net update frequency of actors to their activity.
+ *
+ * A few times per second this subsystem rates every registered actor by its distance to the closest player pawn and by
+ * whether it is moving towards it, and scales its net update frequency and priority between the configured minimum
+ * and the values the actor was registered with.
+ * It also drops the cosmetic events of actors whose channel to any client has its reliable buffer backing up, so they do
+ * not compete for the saturated connection with the reliable traffic waiting to be resent.
+ */
+
+#include "../Public/NetActivitySubsystem.h"
+#include "../../QORPOTestJulian.h"
+#include "../../Core/Public/ShooterReplicationGraph.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Engine/ActorChannel.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Net Activity Evaluation"), STAT_NetActivityEvaluation, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Net Activity Actors"), STAT_NetActivityActors, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Net Activity Threatening Actors"), STAT_NetActivityThreateningActors, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Net Activity Forced Updates"), STAT_NetActivityForcedUpdates, STATGROUP_QORPOTestJulian);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Average Net Update Frequency"), STAT_AverageNetUpdateFrequency, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sent Cosmetic Events"), STAT_SentCosmeticEvents, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped Cosmetic Events"), STAT_DroppedCosmeticEvents, STATGROUP_QORPOTestJulian);
+
+/**
+ * Starts adapting the net update frequency and priority of an actor, from their current values.
+ * Ignored for actors not replicated or without authority.
+ * @param Actor The actor to adapt.
+ */
+void UNetActivitySubsystem::RegisterActor(AActor* Actor)
+{
+	if (!IsValid(Actor) || !Actor->GetIsReplicated() || !Actor->HasAuthority() || Entries.ContainsByPredicate([Actor](const FNetActivityEntry& E) { return E.Actor == Actor; }))
+	{
+		return;
+	}
+
+	FNetActivityEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+	Entry.BaseFrequency = Actor->GetNetUpdateFrequency();
+	Entry.BasePriority = Actor->NetPriority;
+	Entry.Frequency = Entry.BaseFrequency;
+}
+
+/**
+ * Stops adapting an actor, restoring its net update frequency and priority.
+ * @param Actor The actor to forget.
+ */
+void UNetActivitySubsystem::UnregisterActor(AActor* Actor)
+{
+	const int Index = Entries.IndexOfByPredicate([Actor](const FNetActivityEntry& E) { return E.Actor.Get() == Actor; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (IsValid(Actor))
+	{
+		ApplyFrequency(Actor, Entries[Index].BaseFrequency);
+		Actor->NetPriority = Entries[Index].BasePriority;
+	}
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+/**
+ * Returns whether a cosmetic event of an actor should be sent to the clients.
+ * Multicasts reach every client the actor is relevant to, so a single client with a backed up channel drops the event
+ * for all of them; cosmetic events are unreliable and losing one is harmless.
+ * @param Actor The actor sending the event.
+ * @return False if the reliable buffer of any client channel of the actor is over the watermark.
+ */
+bool UNetActivitySubsystem::CanSendCosmeticEvent(AActor* Actor)
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!IsValid(Actor) || !IsValid(NetDriver))
+	{
+		return true;
+	}
+
+	const int Watermark = FMath::CeilToInt(RELIABLE_BUFFER * ReliableBufferWatermark);
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		const UActorChannel* Channel = IsValid(Connection) ? Connection->FindActorChannelRef(Actor) : nullptr;
+		if (Channel != nullptr && Channel->NumOutRec >= Watermark)
+		{
+			INC_DWORD_STAT(STAT_DroppedCosmeticEvents);
+
+			return false;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_SentCosmeticEvents);
+
+	return true;
+}
+
+/**
+ * Rates every registered actor once the evaluation interval has elapsed.
+ * The player pawns are gathered once per rating; pooled-off (hidden) actors are skipped, since they are dormant anyway,
+ * and actors destroyed without unregistering are dropped.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void UNetActivitySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RemainingTime -= DeltaTime;
+	if (RemainingTime > 0.0f)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_NetActivityEvaluation);
+
+	RemainingTime = EvaluationInterval;
+	ViewerLocations.Reset();
+	for (FConstPlayerControllerIterator I = GetWorld()->GetPlayerControllerIterator(); I; ++I)
+	{
+		const APlayerController* Controller = I->Get();
+		const APawn* Pawn = IsValid(Controller) ? Controller->GetPawn() : nullptr;
+		if (IsValid(Pawn))
+		{
+			ViewerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	int ThreateningActors = 0;
+	float FrequencySum = 0.0f;
+	for (int i = Entries.Num() - 1; i >= 0; i--)
+	{
+		AActor* Actor = Entries[i].Actor.Get();
+		if (!IsValid(Actor))
+		{
+			Entries.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+		else if (!Actor->IsHidden())
+		{
+			ThreateningActors += EvaluateActor(Entries[i], Actor) ? 1 : 0;
+		}
+
+		FrequencySum += Entries[i].Frequency;
+	}
+
+	SET_DWORD_STAT(STAT_NetActivityActors, Entries.Num());
+	SET_DWORD_STAT(STAT_NetActivityThreateningActors, ThreateningActors);
+	SET_FLOAT_STAT(STAT_AverageNetUpdateFrequency, Entries.IsEmpty() ? 0.0f : FrequencySum / Entries.Num());
+}
+
+/**
+ * Returns whether there is any actor to adapt on a server.
+ * @return True if adaptation is enabled, actors are registered and the world replicates to clients.
+ */
+bool UNetActivitySubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+
+	return bEnableAdaptiveFrequency && !Entries.IsEmpty() && IsValid(World) && World->GetNetMode() != NM_Standalone && World->GetNetMode() != NM_Client;
+}
+
+/**
+ * Returns the stat used to profile the subsystem tick.
+ * @return The stat identifier.
+ */
+TStatId UNetActivitySubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_NetActivityEvaluation);
+}
+
+/**
+ * Only creates the subsystem for game and PIE worlds.
+ * @param WorldType The type of the world the subsystem would be created for.
+ * @return True if the world type is supported.
+ */
+bool UNetActivitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * Rates the activity of an actor and applies its net update frequency and priority.
+ * The rating goes from 1 at the near distance of the closest player to 0 at the far distance; idle actors keep only
+ * a fraction of it, and actors moving towards a player within the far distance are rated 1.
+ * The frequency is only applied when it changes by more than the hysteresis, and a raise forces a net update.
+ * @param Entry The entry of the actor.
+ * @param Actor The actor to rate.
+ * @return True if the actor is moving towards a player.
+ */
+bool UNetActivitySubsystem::EvaluateActor(FNetActivityEntry& Entry, AActor* Actor)
+{
+	const FVector Location = Actor->GetActorLocation();
+	FVector ToViewer = FVector::ZeroVector;
+	float MinDistanceSquared = TNumericLimits<float>::Max();
+	for (const FVector& ViewerLocation : ViewerLocations)
+	{
+		const float DistanceSquared = FVector::DistSquared(Location, ViewerLocation);
+		if (DistanceSquared < MinDistanceSquared)
+		{
+			MinDistanceSquared = DistanceSquared;
+			ToViewer = ViewerLocation - Location;
+		}
+	}
+
+	const float Range = FMath::Max(FarDistance - NearDistance, 1.0f);
+	float Rating = ViewerLocations.IsEmpty() ? 0.0f : 1.0f - FMath::Clamp((FMath::Sqrt(MinDistanceSquared) - NearDistance) / Range, 0.0f, 1.0f);
+	const FVector Velocity = Actor->GetVelocity();
+	const bool bMoving = Velocity.SizeSquared() > 1.0f;
+	const bool bThreatening = bMoving && Rating > 0.0f && (Velocity | ToViewer) > 0.0f;
+	if (bThreatening)
+	{
+		Rating = 1.0f;
+	}
+	else if (!bMoving)
+	{
+		Rating *= IdleFrequencyScale;
+	}
+
+	const float Frequency = FMath::Lerp(FMath::Min(MinNetUpdateFrequency, Entry.BaseFrequency), Entry.BaseFrequency, Rating);
+	Actor->NetPriority = Entry.BasePriority * (bThreatening ? ThreatPriorityScale : FMath::Lerp(DistantPriorityScale, 1.0f, Rating));
+	if (FMath::Abs(Frequency - Entry.Frequency) > Entry.Frequency * FrequencyHysteresis)
+	{
+		ApplyFrequency(Actor, Frequency);
+		if (Frequency > Entry.Frequency)
+		{
+			Actor->ForceNetUpdate();
+			INC_DWORD_STAT(STAT_NetActivityForcedUpdates);
+		}
+
+		Entry.Frequency = Frequency;
+	}
+
+	return bThreatening;
+}
+
+/**
+ * Sets the net update frequency of an actor, in the replication graph too if it is used.
+ * The graph replicates actors at the period of their class settings, so the period of the actor is overridden there.
+ * @param Actor The actor to update.
+ * @param Frequency The new net update frequency.
+ */
+void UNetActivitySubsystem::ApplyFrequency(AActor* Actor, const float Frequency) const
+{
+	Actor->SetNetUpdateFrequency(Frequency);
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	UShooterReplicationGraph* Graph = IsValid(NetDriver) ? Cast<UShooterReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+	if (IsValid(Graph))
+	{
+		Graph->SetActorReplicationFrequency(Actor, Frequency);
+	}
+}
\ No newline at end of file
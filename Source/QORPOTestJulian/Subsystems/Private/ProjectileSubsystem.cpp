@@ -0,0 +1,437 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file ProjectileSubsystem.cpp
+ * @brief Implements the logic for the UProjectileSubsystem class, which simulates projectiles as plain data in batched passes.
+ *
+ * This subsystem stores every projectile in contiguous arrays, advances them once per frame using sphere sweeps
+ * (optionally asynchronous), applies impact damage and gathers the impacts so cosmetic effects can be handled in one place.
+ * Projectile actors can still be attached to the simulation as visual proxies, or be replaced by one instanced static mesh
+ * per projectile class whose instance transforms are updated in a single batch per pass.
+ */
+
+#include "../Public/ProjectileSubsystem.h"
+#include "Engine/DamageEvents.h"
+#include "../../QORPOTestJulian.h"
+#include "../../Weapons/Public/BaseProjectile.h"
+#include "../../Interactables/Public/BaseItem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Simulation"), STAT_ProjectileSimulation, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Projectiles"), STAT_SimulatedProjectiles, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Sweeps"), STAT_ProjectileSweeps, STATGROUP_QORPOTestJulian);
+DECLARE_CYCLE_STAT(TEXT("Projectile Proxy Update"), STAT_ProjectileProxyUpdate, STATGROUP_QORPOTestJulian);
+DECLARE_CYCLE_STAT(TEXT("Projectile Instance Update"), STAT_ProjectileInstanceUpdate, STATGROUP_QORPOTestJulian);
+
+/**
+ * Default constructor.
+ * Sets up the object types the projectiles can collide with, hitting enemies through their meshes like projectile actors.
+ */
+UProjectileSubsystem::UProjectileSubsystem()
+{
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
+	ObjectParams.AddObjectTypesToQuery(ECC_Enemy);
+}
+
+/**
+ * Starts simulating a new projectile.
+ * Attaches the optional proxy so it follows the simulated position, detaching it from any older projectile
+ * still in flight (pooled proxies are recycled by their weapon).
+ * When instanced visuals are used, the projectile is drawn by the visual group of the proxy's class instead.
+ * @param Parameters The launch parameters of the projectile.
+ * @return The index of the projectile in the simulation arrays (only valid until the next pass).
+ */
+int UProjectileSubsystem::LaunchProjectile(const FProjectileLaunchParameters& Parameters)
+{
+	if (IsValid(Parameters.Proxy))
+	{
+		for (FProjectilePayload& P : Payloads)
+		{
+			if (P.Proxy == Parameters.Proxy)
+			{
+				P.Proxy = nullptr;
+			}
+		}
+	}
+
+	FProjectileSimulationState& State = States.AddDefaulted_GetRef();
+	State.Position = Parameters.Origin;
+	State.Velocity = Parameters.Direction.GetSafeNormal() * Parameters.Speed;
+	State.RemainingLifeTime = Parameters.LifeTime;
+	State.CollisionRadius = Parameters.CollisionRadius;
+	State.VisualGroup = bUseInstancedVisuals && IsValid(Parameters.Proxy) ? FindOrAddVisualGroup(Parameters.Proxy) : INDEX_NONE;
+
+	FProjectilePayload& Payload = Payloads.AddDefaulted_GetRef();
+	Payload.Damage = Parameters.Damage;
+	Payload.Causer = Parameters.Causer;
+	Payload.IgnoredActor = Parameters.IgnoredActor;
+	Payload.Instigator = Parameters.Instigator;
+	Payload.Proxy = Parameters.Proxy;
+
+	return States.Num() - 1;
+}
+
+/**
+ * Stops simulating every projectile displayed by the given proxy, without impact nor deactivation event.
+ * Used to discard predicted projectiles the server did not confirm.
+ * @param Proxy The projectile actor displaying the projectiles to cancel.
+ */
+void UProjectileSubsystem::CancelProjectile(const ABaseProjectile* Proxy)
+{
+	for (int i = States.Num() - 1; i >= 0; i--)
+	{
+		if (Payloads[i].Proxy.Get() == Proxy)
+		{
+			States.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			Payloads.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+/**
+ * Returns the impacts resolved during the last simulation pass.
+ * @return The impacts of the last pass.
+ */
+const TArray<FProjectileImpact> UProjectileSubsystem::GetFrameImpacts() const
+{
+	return FrameImpacts;
+}
+
+/**
+ * Returns the number of projectiles currently simulated.
+ * @return The active projectile count.
+ */
+const int UProjectileSubsystem::GetActiveProjectileCount() const
+{
+	return States.Num();
+}
+
+/**
+ * Returns whether projectiles are drawn through instanced meshes instead of their proxy actors.
+ * @return True if instanced visuals are used.
+ */
+const bool UProjectileSubsystem::UsesInstancedVisuals() const
+{
+	return bUseInstancedVisuals;
+}
+
+/**
+ * Advances every simulated projectile in one batched pass.
+ * Resolves the asynchronous sweeps issued on the previous pass, moves the projectiles, sweeps their paths,
+ * then updates the proxies and instanced visuals and broadcasts the impacts of the pass.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileSimulation);
+
+	UWorld* World = GetWorld();
+	FrameImpacts.Reset();
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	// Iterate backwards so removed projectiles are swapped with already processed ones
+	FTraceDatum TraceDatum = FTraceDatum();
+	TArray<FHitResult> Hits = TArray<FHitResult>();
+	for (int i = States.Num() - 1; i >= 0; i--)
+	{
+		FProjectileSimulationState& State = States[i];
+		FProjectilePayload& Payload = Payloads[i];
+		if (Payload.SweepHandle.IsValid() && World->QueryTraceData(Payload.SweepHandle, TraceDatum))
+		{
+			Payload.SweepHandle = FTraceHandle();
+			const FHitResult* ImpactHit = FindImpactHit(TraceDatum.OutHits, Payload);
+			if (ImpactHit != nullptr)
+			{
+				ImpactProjectile(i, *ImpactHit);
+				continue;
+			}
+		}
+
+		State.RemainingLifeTime -= DeltaTime;
+		if (State.RemainingLifeTime <= 0.0f)
+		{
+			RemoveProjectile(i);
+			continue;
+		}
+
+		const FVector Start = State.Position;
+		const FVector End = Start + State.Velocity * DeltaTime;
+		const FCollisionShape Shape = FCollisionShape::MakeSphere(State.CollisionRadius);
+		INC_DWORD_STAT(STAT_ProjectileSweeps);
+		if (bUseAsyncSweeps)
+		{
+			Payload.SweepHandle = World->AsyncSweepByObjectType(EAsyncTraceType::Multi, Start, End, FQuat::Identity,
+				ObjectParams, Shape, MakeQueryParams(Payload));
+			State.Position = End;
+			continue;
+		}
+
+		Hits.Reset();
+		World->SweepMultiByObjectType(Hits, Start, End, FQuat::Identity, ObjectParams, Shape, MakeQueryParams(Payload));
+		const FHitResult* ImpactHit = FindImpactHit(Hits, Payload);
+		if (ImpactHit != nullptr)
+		{
+			ImpactProjectile(i, *ImpactHit);
+			continue;
+		}
+
+		State.Position = End;
+	}
+
+	UpdateProxyVisuals();
+	UpdateInstancedVisuals();
+
+	SET_DWORD_STAT(STAT_SimulatedProjectiles, States.Num());
+	if (!FrameImpacts.IsEmpty())
+	{
+		OnProjectileImpacts.Broadcast(FrameImpacts);
+	}
+}
+
+/**
+ * Returns whether the subsystem has any projectile to simulate or instances to clear.
+ * @return True if at least one projectile is active or still drawn.
+ */
+bool UProjectileSubsystem::IsTickable() const
+{
+	return !States.IsEmpty() || bVisualInstancesInUse;
+}
+
+/**
+ * Returns the stat used to profile the subsystem tick.
+ * @return The stat identifier.
+ */
+TStatId UProjectileSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_ProjectileSimulation);
+}
+
+/**
+ * Only creates the subsystem for game and PIE worlds.
+ * @param WorldType The type of the world the subsystem would be created for.
+ * @return True if the world type is supported.
+ */
+bool UProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * Picks the first hit that a projectile is allowed to impact.
+ * Skips the projectile's own actors, other projectiles and items, mirroring ABaseProjectile::ImpactBody.
+ * @param Hits The hits returned by the sweep, sorted by distance.
+ * @param Payload The payload of the swept projectile.
+ * @return The hit to impact, or nullptr if the path is clear.
+ */
+const FHitResult* UProjectileSubsystem::FindImpactHit(const TArray<FHitResult>& Hits, const FProjectilePayload& Payload) const
+{
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		if (HitActor == Payload.IgnoredActor.Get() || HitActor == Payload.Causer.Get() ||
+			IsValid(Cast<ABaseProjectile>(HitActor)) || IsValid(Cast<ABaseItem>(HitActor)))
+		{
+			continue;
+		}
+
+		return &Hit;
+	}
+
+	return nullptr;
+}
+
+/**
+ * Applies the impact of a projectile, records it and removes the projectile from the simulation.
+ * Damage is only applied on the server, through the same TakeDamage call ABaseProjectile::ImpactBody ends up in.
+ * @param Index The index of the projectile.
+ * @param Hit The hit that stopped the projectile.
+ */
+void UProjectileSubsystem::ImpactProjectile(const int Index, const FHitResult& Hit)
+{
+	const FProjectilePayload& Payload = Payloads[Index];
+	AActor* HitActor = Hit.GetActor();
+	AController* Instigator = Payload.Instigator.Get();
+	if (GetWorld()->GetNetMode() != NM_Client && IsValid(HitActor) && IsValid(Instigator))
+	{
+		HitActor->TakeDamage(Payload.Damage, FDamageEvent(), Instigator, Payload.Causer.Get());
+	}
+
+	FProjectileImpact& Impact = FrameImpacts.AddDefaulted_GetRef();
+	Impact.Location = Hit.ImpactPoint;
+	Impact.Normal = Hit.ImpactNormal;
+	Impact.HitActor = HitActor;
+	Impact.Proxy = Payload.Proxy.Get();
+
+	States[Index].Position = Hit.Location;
+	RemoveProjectile(Index);
+}
+
+/**
+ * Removes a projectile from the simulation and disables its proxy.
+ * Instanced projectiles never showed their proxy, so they simply stop being gathered into their visual group.
+ * Clients hide their proxy locally, the server sends the deactivation to every machine.
+ * @param Index The index of the projectile.
+ */
+void UProjectileSubsystem::RemoveProjectile(const int Index)
+{
+	const FProjectileSimulationState& State = States[Index];
+	ABaseProjectile* Proxy = Payloads[Index].Proxy.Get();
+	if (State.VisualGroup == INDEX_NONE && IsValid(Proxy))
+	{
+		Proxy->HasAuthority() ? Proxy->SendProjectileOut(State.Position, State.Velocity.Rotation(), false) :
+			IReusableInterface::Execute_OnTurnEnabled(Proxy, false);
+	}
+
+	States.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Payloads.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+/**
+ * Builds the query parameters used to sweep a projectile.
+ * @param Payload The payload of the swept projectile.
+ * @return The query parameters ignoring the projectile's own actors.
+ */
+FCollisionQueryParams UProjectileSubsystem::MakeQueryParams(const FProjectilePayload& Payload) const
+{
+	FCollisionQueryParams QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ProjectileSweep), false);
+	QueryParams.AddIgnoredActor(Payload.IgnoredActor.Get());
+	QueryParams.AddIgnoredActor(Payload.Causer.Get());
+	QueryParams.AddIgnoredActor(Payload.Proxy.Get());
+
+	return QueryParams;
+}
+
+/**
+ * Returns the visual group drawing the projectiles of the given proxy's class, creating it if needed.
+ * New groups get an instanced mesh component using the proxy's mesh and materials, registered on a transient actor.
+ * @param Proxy The projectile actor whose mesh, materials and scale are instanced.
+ * @return The index of the visual group, or INDEX_NONE if the proxy has no mesh to instance.
+ */
+int UProjectileSubsystem::FindOrAddVisualGroup(const ABaseProjectile* Proxy)
+{
+	const int* GroupIndex = VisualGroupIndices.Find(Proxy->GetClass());
+	if (GroupIndex != nullptr)
+	{
+		return *GroupIndex;
+	}
+
+	UWorld* World = GetWorld();
+	UStaticMeshComponent* MeshComponent = Proxy->GetMeshComponent();
+	if (!IsValid(World) || !IsValid(MeshComponent) || !IsValid(MeshComponent->GetStaticMesh()))
+	{
+		return INDEX_NONE;
+	}
+
+	if (!IsValid(VisualsActor))
+	{
+		FActorSpawnParameters SpawnParameters = FActorSpawnParameters();
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		VisualsActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	}
+
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(VisualsActor);
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCastShadow(MeshComponent->CastShadow);
+	Instances->SetStaticMesh(MeshComponent->GetStaticMesh());
+	for (int i = 0; i < MeshComponent->GetNumMaterials(); i++)
+	{
+		Instances->SetMaterial(i, MeshComponent->GetMaterial(i));
+	}
+
+	Instances->RegisterComponent();
+	VisualsActor->AddInstanceComponent(Instances);
+
+	FProjectileVisualGroup& Group = VisualGroups.AddDefaulted_GetRef();
+	Group.Scale = MeshComponent->GetComponentScale();
+	VisualInstances.Add(Instances);
+
+	return VisualGroupIndices.Add(Proxy->GetClass(), VisualGroups.Num() - 1);
+}
+
+/**
+ * Moves the proxy actors of the projectiles that are not instanced to their simulated transforms.
+ * Every proxy pays its own component transform and render proxy update.
+ */
+void UProjectileSubsystem::UpdateProxyVisuals()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileProxyUpdate);
+
+	for (int i = 0; i < States.Num(); i++)
+	{
+		const FProjectileSimulationState& State = States[i];
+		ABaseProjectile* Proxy = State.VisualGroup == INDEX_NONE ? Payloads[i].Proxy.Get() : nullptr;
+		if (IsValid(Proxy))
+		{
+			Proxy->SetActorLocationAndRotation(State.Position, State.Velocity.Rotation());
+		}
+	}
+}
+
+/**
+ * Gathers the simulated transforms of the instanced projectiles and pushes them to their visual groups in batches.
+ * Each group grows or shrinks its instances at the end only, so no instance is ever reordered,
+ * and then updates every transform with a single call.
+ */
+void UProjectileSubsystem::UpdateInstancedVisuals()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileInstanceUpdate);
+
+	if (VisualGroups.IsEmpty())
+	{
+		return;
+	}
+
+	for (FProjectileVisualGroup& Group : VisualGroups)
+	{
+		Group.Transforms.Reset();
+	}
+
+	bVisualInstancesInUse = false;
+	for (const FProjectileSimulationState& State : States)
+	{
+		if (VisualGroups.IsValidIndex(State.VisualGroup))
+		{
+			FProjectileVisualGroup& Group = VisualGroups[State.VisualGroup];
+			Group.Transforms.Emplace(State.Velocity.Rotation(), State.Position, Group.Scale);
+			bVisualInstancesInUse = true;
+		}
+	}
+
+	for (int i = 0; i < VisualGroups.Num(); i++)
+	{
+		const TArray<FTransform>& Transforms = VisualGroups[i].Transforms;
+		UInstancedStaticMeshComponent* Instances = VisualInstances.IsValidIndex(i) ? VisualInstances[i] : nullptr;
+		const int InstanceCount = IsValid(Instances) ? Instances->GetInstanceCount() : 0;
+		if (!IsValid(Instances) || (InstanceCount == 0 && Transforms.IsEmpty()))
+		{
+			continue;
+		}
+
+		if (Transforms.Num() < InstanceCount)
+		{
+			TArray<int32> RemovedInstances = TArray<int32>();
+			for (int j = InstanceCount - 1; j >= Transforms.Num(); j--)
+			{
+				RemovedInstances.Add(j);
+			}
+
+			Instances->RemoveInstances(RemovedInstances);
+		}
+		else if (Transforms.Num() > InstanceCount)
+		{
+			Instances->AddInstances(TArray<FTransform>(Transforms.GetData() + InstanceCount, Transforms.Num() - InstanceCount), false, true, false);
+		}
+
+		if (!Transforms.IsEmpty())
+		{
+			Instances->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+		}
+	}
+}
\ No newline at end of file
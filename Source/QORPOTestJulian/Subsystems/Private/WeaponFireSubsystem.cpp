@@ -0,0 +1,135 @@
+// Copyright (c) Julin Lpez Baraano. All Rights Reserved.
+
+/**
+ * @file WeaponFireSubsystem.cpp
+ * @brief Implements the logic for the UWeaponFireSubsystem class, which schedules the shots of every firing weapon in one pass.
+ *
+ * This subsystem replaces the per-weapon looping timers: it accumulates the fire time of each active trigger once per frame
+ * and emits every shot due in that frame, passing each one its sub-frame time offset so high cadences stay accurate
+ * at low frame rates.
+ */
+
+#include "../Public/WeaponFireSubsystem.h"
+#include "../../QORPOTestJulian.h"
+#include "../../Weapons/Public/BaseWeapon.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Fire Scheduling"), STAT_WeaponFireScheduling, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Triggers"), STAT_ActiveTriggers, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Shots"), STAT_ScheduledShots, STATGROUP_QORPOTestJulian);
+
+/**
+ * Registers a weapon whose trigger became active.
+ * The first shot is delayed until the weapon's cadence allows it again, so tapping the trigger never fires faster.
+ * @param Weapon The weapon to fire.
+ */
+void UWeaponFireSubsystem::StartFiring(ABaseWeapon* Weapon)
+{
+	UWorld* World = GetWorld();
+	if (!IsValid(World) || !IsValid(Weapon) || Entries.ContainsByPredicate([Weapon](const FWeaponFireEntry& E) { return E.Weapon == Weapon; }))
+	{
+		return;
+	}
+
+	FWeaponFireEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Weapon = Weapon;
+	Entry.RemainingTime = FMath::Max(Weapon->GetNextShotTime() - World->GetTimeSeconds(), 0.0f);
+}
+
+/**
+ * Unregisters a weapon, cancelling its pending shots.
+ * @param Weapon The weapon to stop firing.
+ */
+void UWeaponFireSubsystem::StopFiring(const ABaseWeapon* Weapon)
+{
+	Entries.RemoveAllSwap([Weapon](const FWeaponFireEntry& E) { return E.Weapon == Weapon; }, EAllowShrinking::No);
+}
+
+/**
+ * Returns the number of weapons currently firing.
+ * @return The active trigger count.
+ */
+const int UWeaponFireSubsystem::GetActiveTriggerCount() const
+{
+	return Entries.Num();
+}
+
+/**
+ * Advances the fire time of every registered weapon and emits the shots due in this frame.
+ * Each shot receives how long ago within the frame it was due; weapons whose shot fails (trigger released,
+ * empty magazine) are unregistered.
+ * Firing broadcasts weapon events that can start or stop other weapons, so each entry is copied before its shots
+ * and written back by weapon afterwards, instead of holding a reference into the array.
+ * @param DeltaTime Time elapsed since the last tick.
+ */
+void UWeaponFireSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_WeaponFireScheduling);
+
+	for (int i = Entries.Num() - 1; i >= 0; i--)
+	{
+		if (!Entries.IsValidIndex(i))
+		{
+			continue;
+		}
+
+		FWeaponFireEntry Entry = Entries[i];
+		ABaseWeapon* Weapon = Entry.Weapon.Get();
+		bool bFiring = IsValid(Weapon);
+		Entry.RemainingTime -= DeltaTime;
+		for (int Shots = 0; bFiring && Entry.RemainingTime <= 0.0f && Shots < MaxShotsPerFrame; Shots++)
+		{
+			bFiring = Weapon->FireScheduledShot(FMath::Min(-Entry.RemainingTime, DeltaTime));
+			Entry.RemainingTime += Weapon->GetShotInterval();
+			if (bFiring)
+			{
+				INC_DWORD_STAT(STAT_ScheduledShots);
+			}
+		}
+
+		const int Index = Entries.IndexOfByPredicate([&Entry](const FWeaponFireEntry& E) { return E.Weapon == Entry.Weapon; });
+		if (Index == INDEX_NONE)
+		{
+			continue;
+		}
+		else if (!bFiring)
+		{
+			Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+		else
+		{
+			Entries[Index].RemainingTime = FMath::Max(Entry.RemainingTime, 0.0f);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ActiveTriggers, Entries.Num());
+}
+
+/**
+ * Returns whether any weapon is firing.
+ * @return True if at least one trigger is active.
+ */
+bool UWeaponFireSubsystem::IsTickable() const
+{
+	return !Entries.IsEmpty();
+}
+
+/**
+ * Returns the stat used to profile the subsystem tick.
+ * @return The stat identifier.
+ */
+TStatId UWeaponFireSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_WeaponFireScheduling);
+}
+
+/**
+ * Only creates the subsystem for game and PIE worlds.
+ * @param WorldType The type of the world the subsystem would be created for.
+ * @return True if the world type is supported.
+ */
+bool UWeaponFireSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/CapsuleComponent.h"
+
+#include "ContactDamageSubsystem.generated.h"
+
+class ABaseEnemy;
+
+/**
+ * FContactTarget
+ *
+ * Actor that enemies damage on contact, detected through its capsule.
+ */
+struct FContactTarget
+{
+	/** Actor damaged on contact. */
+	TWeakObjectPtr<AActor> Actor = nullptr;
+
+	/** Upright capsule used as the contact volume of the actor. */
+	TWeakObjectPtr<UCapsuleComponent> Capsule = nullptr;
+};
+
+/**
+ * FContactCapsule
+ *
+ * Contact volume of a target gathered for the current pass: the vertical segment of its capsule and its radius.
+ */
+struct FContactCapsule
+{
+	/** Actor owning the capsule. */
+	AActor* Actor = nullptr;
+
+	/** World center of the capsule. */
+	FVector Center = FVector::ZeroVector;
+
+	/** Half length of the capsule segment, without the hemispheres. */
+	float HalfSegment = 0.0f;
+
+	/** Radius of the capsule. */
+	float Radius = 0.0f;
+};
+
+/**
+ * UContactDamageSubsystem
+ *
+ * World subsystem that detects enemy contacts with the players in one batched pass per frame, instead of overlap events.
+ * The bounds of every active enemy are tested against the few target capsules, which are treated as upright, so the
+ * distance between an axis-aligned box and the capsule segment is computed exactly with a handful of operations.
+ * Contacts are gathered first and handled after the pass, so the enemies they disable do not disturb it.
+ */
+UCLASS(config = Game)
+class QORPOTESTJULIAN_API UContactDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Starts testing the contacts of an enemy.
+	 * @param Enemy The enemy dealing contact damage.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Contact")
+	void RegisterEnemy(ABaseEnemy* Enemy);
+
+	/**
+	 * Stops testing the contacts of an enemy.
+	 * @param Enemy The enemy to forget.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Contact")
+	void UnregisterEnemy(const ABaseEnemy* Enemy);
+
+	/**
+	 * Starts testing the enemies against the capsule of an actor.
+	 * @param Actor The actor damaged on contact.
+	 * @param Capsule The upright capsule used as the contact volume of the actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Contact")
+	void RegisterTarget(AActor* Actor, UCapsuleComponent* Capsule);
+
+	/**
+	 * Stops testing the enemies against an actor.
+	 * @param Actor The actor to forget.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Contact")
+	void UnregisterTarget(const AActor* Actor);
+
+	/**
+	 * Tests every active enemy against every target and handles the contacts found.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns whether there are both enemies and targets to test. */
+	virtual bool IsTickable() const override;
+
+	/** Returns the stat used to profile the subsystem tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Enemies dealing contact damage. */
+	TArray<TWeakObjectPtr<ABaseEnemy>> Enemies = TArray<TWeakObjectPtr<ABaseEnemy>>();
+
+	/** Actors damaged on contact. */
+	TArray<FContactTarget> Targets = TArray<FContactTarget>();
+
+	/** Target capsules gathered for the current pass. */
+	TArray<FContactCapsule> Capsules = TArray<FContactCapsule>();
+
+	/** Enemy and target of every contact found in the current pass. */
+	TArray<TPair<ABaseEnemy*, AActor*>> Contacts = TArray<TPair<ABaseEnemy*, AActor*>>();
+
+	/**
+	 * Only creates the subsystem for game and PIE worlds.
+	 * @param WorldType The type of the world the subsystem would be created for.
+	 * @return True if the world type is supported.
+	 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Returns whether a box touches an upright capsule.
+	 * @param Bounds The world box to test.
+	 * @param Capsule The capsule to test.
+	 * @return True if the box and the capsule touch.
+	 */
+	static bool IsTouching(const FBox& Bounds, const FContactCapsule& Capsule);
+};
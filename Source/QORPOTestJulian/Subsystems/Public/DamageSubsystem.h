@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/DamageEvents.h"
+#include "../../Components/Public/AttributesComponent.h"
+
+#include "DamageSubsystem.generated.h"
+
+/**
+ * FQueuedDamage
+ *
+ * Damage event waiting in the damage subsystem queue until the end of the frame.
+ * Holds everything the falloff pass needs as plain values, so the pass can run off the game thread.
+ */
+struct FQueuedDamage
+{
+	/** Attributes of the actor receiving the damage. */
+	TWeakObjectPtr<UAttributesComponent> Attributes = nullptr;
+
+	/** Controller responsible for the damage, credited if it depletes the receiver's health. */
+	TWeakObjectPtr<AController> Instigator = nullptr;
+
+	/** Radius, inner radius and falloff of radial damage. */
+	FRadialDamageParams RadialParams = FRadialDamageParams();
+
+	/** Origin of radial damage. */
+	FVector Origin = FVector::ZeroVector;
+
+	/** Position of the receiver when the damage was queued. */
+	FVector Position = FVector::ZeroVector;
+
+	/** Health change of flat damage (negative), or the value scaled by the falloff of radial damage (positive). */
+	float Amount = 0.0f;
+
+	/** Whether the amount is scaled by the radial falloff from the origin to the receiver. */
+	bool bRadial = false;
+};
+
+/**
+ * FDamageReceiverTotal
+ *
+ * Net health change of a single receiver, accumulated from every damage event resolved in the frame.
+ */
+struct FDamageReceiverTotal
+{
+	/** Attributes of the actor receiving the damage. */
+	TWeakObjectPtr<UAttributesComponent> Attributes = nullptr;
+
+	/** Last controller that damaged the receiver this frame. */
+	TWeakObjectPtr<AController> Instigator = nullptr;
+
+	/** Sum of the health changes of the frame. */
+	float Amount = 0.0f;
+};
+
+/**
+ * UDamageSubsystem
+ *
+ * World subsystem that resolves every damage event of a frame in one batch instead of on each hit.
+ * TakeDamage entry points queue their events; once per frame the radial falloff of all of them is evaluated in a parallel
+ * pass, the health changes are summed per receiver and applied with a single health reaction (and a single health broadcast).
+ * Healing is not queued, since its callers need to know right away whether it succeeded.
+ */
+UCLASS(config = Game)
+class QORPOTESTJULIAN_API UDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Builds a queued damage event from a generic, point or radial damage event.
+	 * Receivers apply their amount modifiers afterwards.
+	 * @param Receiver The actor receiving the damage.
+	 * @param Attributes The attributes of the receiver.
+	 * @param DamageAmount The amount of flat damage (unused by radial damage).
+	 * @param DamageEvent The event describing the type of damage.
+	 * @param Instigator The controller responsible for the damage.
+	 * @return The queued damage, without attributes if the event type is not queued.
+	 */
+	static FQueuedDamage MakeQueuedDamage(const AActor* Receiver, UAttributesComponent* Attributes, const float DamageAmount, FDamageEvent const& DamageEvent, AController* Instigator);
+
+	/**
+	 * Queues a damage event until the end of the frame.
+	 * @param Damage The damage to queue.
+	 * @return The flat health change queued, or zero for radial damage (resolved with the batch).
+	 */
+	float QueueDamage(const FQueuedDamage& Damage);
+
+	/**
+	 * Returns the number of damage events waiting for the next pass.
+	 * @return The queued damage count.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Damage")
+	const int GetQueuedDamageCount() const;
+
+	/**
+	 * Resolves every queued damage event in one batched pass.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns whether there is any damage to resolve. */
+	virtual bool IsTickable() const override;
+
+	/** Returns the stat used to profile the subsystem tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Minimum number of queued events for the falloff pass to be spread across worker threads. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Damage", meta = (ClampMin = 1, ClampMax = 4096))
+	int ParallelBatchThreshold = 64;
+
+	/** Damage events queued during the current frame. */
+	TArray<FQueuedDamage> Queue = TArray<FQueuedDamage>();
+
+	/** Damage events being resolved, swapped with the queue so damage caused while applying waits for the next pass. */
+	TArray<FQueuedDamage> Resolving = TArray<FQueuedDamage>();
+
+	/** Health change of every resolving event, parallel to Resolving. */
+	TArray<float> Deltas = TArray<float>();
+
+	/** Net health change of every receiver of the pass. */
+	TArray<FDamageReceiverTotal> Totals = TArray<FDamageReceiverTotal>();
+
+	/** Index in Totals of every receiver of the pass. */
+	TMap<const UAttributesComponent*, int> TotalIndices = TMap<const UAttributesComponent*, int>();
+
+	/**
+	 * Only creates the subsystem for game and PIE worlds.
+	 * @param WorldType The type of the world the subsystem would be created for.
+	 * @return True if the world type is supported.
+	 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/DamageEvents.h"
+#include "GameFramework/MovementComponent.h"
+
+#include "ExplosionSubsystem.generated.h"
+
+class UFieldSystemComponent;
+class URadialFalloff;
+class URadialVector;
+class UOperatorField;
+class APawn;
+
+/**
+ * FPendingExplosion
+ *
+ * Explosion waiting for its turn in the explosion budget, or for the result of its overlap query.
+ */
+struct FPendingExplosion
+{
+	/** Radial damage dealt by the explosion, including its origin and radii. */
+	FRadialDamageEvent DamageEvent = FRadialDamageEvent();
+
+	/** Multiplier of the base damage giving the impulse of the explosion. */
+	float ImpulseStrength = 0.0f;
+
+	/** Actor that exploded, reported as the damage causer and never affected by its own explosion. */
+	TWeakObjectPtr<AActor> Causer = nullptr;
+
+	/** Controller responsible for the explosion. */
+	TWeakObjectPtr<AController> Instigator = nullptr;
+
+	/** Handle of the asynchronous overlap query issued for the explosion, if any. */
+	FTraceHandle OverlapHandle = FTraceHandle();
+
+	/** Frame number when the overlap query was issued. */
+	uint64 QueryFrame = 0;
+};
+
+/**
+ * FPawnKnockback
+ *
+ * Velocity change accumulated for a pawn from every explosion resolved in the frame.
+ */
+struct FPawnKnockback
+{
+	/** Movement component of the pushed pawn. */
+	TWeakObjectPtr<UMovementComponent> Movement = nullptr;
+
+	/** Sum of the velocity changes of the frame. */
+	FVector VelocityChange = FVector::ZeroVector;
+};
+
+/**
+ * UExplosionSubsystem
+ *
+ * World subsystem that resolves explosions through asynchronous sphere overlap queries instead of toggling collision
+ * and damaging the overlapping actors within the same call stack.
+ * Explosions are started under a per-frame budget and resolved the following frame; the damage they deal is queued in
+ * the damage subsystem, so chained detonations are scheduled on later frames instead of recursing.
+ * Each explosion pushes the physics bodies around it through a single transient Chaos radial impulse field, and the pawns
+ * it reaches through one knockback per pawn accumulated over the frame.
+ */
+UCLASS(config = Game)
+class QORPOTESTJULIAN_API UExplosionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor. Initializes the overlap query parameters. */
+	UExplosionSubsystem();
+
+	/**
+	 * Queues an explosion to be resolved once the per-frame budget allows it.
+	 * @param Causer The actor exploding.
+	 * @param DamageEvent The radial damage of the explosion, including its origin and radii.
+	 * @param ImpulseStrength The multiplier of the base damage giving the impulse of the explosion.
+	 * @param Instigator The controller responsible for the explosion.
+	 */
+	void QueueExplosion(AActor* Causer, const FRadialDamageEvent& DamageEvent, const float ImpulseStrength, AController* Instigator);
+
+	/**
+	 * Returns the number of explosions queued or waiting for their overlap query.
+	 * @return The pending explosion count.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Explosion")
+	const int GetPendingExplosionCount() const;
+
+	/**
+	 * Resolves the overlap queries issued on the previous frame, applies the knockback they caused, and starts the queued
+	 * explosions within budget.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns whether there is any explosion to start or resolve. */
+	virtual bool IsTickable() const override;
+
+	/** Returns the stat used to profile the subsystem tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Maximum number of explosions started per frame; the rest wait for the following frames. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Explosion", meta = (ClampMin = 1, ClampMax = 64))
+	int MaxExplosionsPerFrame = 4;
+
+	/** Whether explosions push physics bodies through a Chaos field; disabled, bodies are only damaged. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+	bool bUsePhysicsFields = true;
+
+	/** Explosions waiting for their turn in the budget, in order of detonation. */
+	TArray<FPendingExplosion> Queue = TArray<FPendingExplosion>();
+
+	/** Explosions whose overlap query has been issued and is resolved on the following frame. */
+	TArray<FPendingExplosion> InFlight = TArray<FPendingExplosion>();
+
+	/** Object types the explosions can affect. */
+	FCollisionObjectQueryParams ObjectParams = FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects);
+
+	/** Actors gathered from the overlaps of the explosion being applied. */
+	TArray<AActor*> AffectedActors = TArray<AActor*>();
+
+	/** Knockback of every pawn reached by the explosions of the frame. */
+	TArray<FPawnKnockback> Knockbacks = TArray<FPawnKnockback>();
+
+	/** Index in Knockbacks of every pushed movement component. */
+	TMap<const UMovementComponent*, int> KnockbackIndices = TMap<const UMovementComponent*, int>();
+
+	/** Transient actor owning the field system component. */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Explosion")
+	AActor* FieldActor = nullptr;
+
+	/** Field system component emitting the explosion fields to the physics solver. */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Explosion")
+	UFieldSystemComponent* FieldComponent = nullptr;
+
+	/** Field node giving the impulse magnitude, fading linearly to the explosion radius. */
+	UPROPERTY(Transient)
+	URadialFalloff* FieldFalloff = nullptr;
+
+	/** Field node giving the impulse direction, away from the explosion origin. */
+	UPROPERTY(Transient)
+	URadialVector* FieldDirection = nullptr;
+
+	/** Field node multiplying the magnitude by the direction. */
+	UPROPERTY(Transient)
+	UOperatorField* FieldOperator = nullptr;
+
+	/**
+	 * Only creates the subsystem for game and PIE worlds.
+	 * @param WorldType The type of the world the subsystem would be created for.
+	 * @return True if the world type is supported.
+	 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Deals the damage of an explosion to every actor it overlaps, once per actor.
+	 * @param Explosion The explosion to apply.
+	 * @param Overlaps The overlaps of the explosion sphere.
+	 */
+	void ApplyExplosion(const FPendingExplosion& Explosion, const TArray<FOverlapResult>& Overlaps);
+
+	/**
+	 * Emits a transient radial impulse field for an explosion, creating the field component if needed.
+	 * @param Explosion The exploding explosion.
+	 */
+	void EmitImpulseField(const FPendingExplosion& Explosion);
+
+	/**
+	 * Accumulates the knockback of an explosion on a pawn.
+	 * @param Pawn The pawn reached by the explosion.
+	 * @param Explosion The explosion pushing the pawn.
+	 */
+	void AddKnockback(APawn* Pawn, const FPendingExplosion& Explosion);
+
+	/** Applies the knockback accumulated by every pawn during the frame, once per pawn. */
+	void ApplyKnockbacks();
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+
+#include "LagCompensationSubsystem.generated.h"
+
+/**
+ * FRewoundHit
+ *
+ * Result of a line tested against the rewound hit volumes of the lag compensation history.
+ */
+struct FRewoundHit
+{
+	/** Actor owning the hit volume crossed first by the line. */
+	TWeakObjectPtr<AActor> Actor = nullptr;
+
+	/** World position where the line enters the rewound hit volume. */
+	FVector Location = FVector::ZeroVector;
+
+	/** Fraction of the line, from 0 to 1, at which the hit volume is entered. */
+	float Time = 1.0f;
+};
+
+/**
+ * ULagCompensationSubsystem
+ *
+ * Server-side world subsystem that records the hit volumes (world bounds) of the registered enemies and players
+ * in a ring buffer of snapshots, so hit-scan shots can be resolved against the positions the shooter was seeing.
+ * Each snapshot stores the volume centers and extents as separate float arrays (structure of arrays), letting the
+ * rewind interpolate and ray test four volumes per instruction.
+ * The memory cost is HistoryFrames * MaxTrackedActors * 6 floats, and the snapshots are spaced so the buffer always
+ * covers MaxRewindTime regardless of the frame rate.
+ * Shots are rewound by the shooter's round trip plus the interpolation delay of the enemy movement proxies, and the sum
+ * is clamped by MaxRewindTime, so MaxRewindTime minus the proxy InterpolationDelay is the highest round trip fully compensated.
+ */
+UCLASS(config = Game)
+class QORPOTESTJULIAN_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Allocates the snapshot history from the configured limits.
+	 * @param Collection The collection of subsystems being initialized.
+	 */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * Starts recording the hit volume of an actor, filling its whole history with the current bounds.
+	 * Rejected, counted and logged once when no free slot is left; only reserved registrations can use the player slots.
+	 * @param Actor The actor to rewind.
+	 * @param Volume The component whose world bounds are used as the actor's hit volume.
+	 * @param bReservedSlot Whether the volume can use the slots reserved for players.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	void RegisterHitVolume(AActor* Actor, UPrimitiveComponent* Volume, const bool bReservedSlot = false);
+
+	/**
+	 * Stops recording the hit volume of an actor.
+	 * @param Actor The actor to forget.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	void UnregisterHitVolume(const AActor* Actor);
+
+	/**
+	 * Returns whether the hit volume of an actor is recorded.
+	 * @param Actor The actor to check.
+	 * @return True if hits against the actor should be resolved through the history.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	const bool IsTracked(const AActor* Actor) const;
+
+	/**
+	 * Returns whether shots of the given controller should be resolved against the rewound history.
+	 * Only remote players on the server are compensated; local shots already see current positions.
+	 * @param Controller The controller of the shooter.
+	 * @return True if the shot should be rewound.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	const bool ShouldRewind(const AController* Controller) const;
+
+	/**
+	 * Sets the time clients render the interpolated enemies behind their last received sample, keeping the longest one
+	 * reported by the enemy movement proxies.
+	 * @param Delay The interpolation delay in seconds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	void SetInterpolationDelay(const float Delay);
+
+	/**
+	 * Returns the server time the given shooter was seeing when firing: its round trip plus the interpolation delay
+	 * before now, clamped to the recorded window.
+	 * @param Controller The controller of the shooter.
+	 * @return The world time to rewind to.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	const float GetViewTime(const AController* Controller) const;
+
+	/**
+	 * Returns the maximum time in seconds a shot can be rewound.
+	 * @return The rewind window.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	const float GetMaxRewindTime() const;
+
+	/**
+	 * Tests a line against every hit volume as it was at the given time, interpolating between the bracketing snapshots.
+	 * @param Start The start of the line.
+	 * @param End The end of the line.
+	 * @param Time The world time to rewind to.
+	 * @param IgnoredActor Actor whose volume is skipped (usually the shooter).
+	 * @param OutHit Set to the closest volume crossed by the line.
+	 * @return True if any volume is crossed.
+	 */
+	bool RewindLineTrace(const FVector& Start, const FVector& End, const float Time, const AActor* IgnoredActor, FRewoundHit& OutHit) const;
+
+	/**
+	 * Records a snapshot of every hit volume when the snapshot interval has elapsed.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns whether there is any hit volume to record on the server. */
+	virtual bool IsTickable() const override;
+
+	/** Returns the stat used to profile the subsystem tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Whether remote shots are resolved against the rewound history at all. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Lag Compensation")
+	bool bEnableLagCompensation = true;
+
+	/** Maximum time in seconds a shot can be rewound; should cover the highest compensated round trip plus the interpolation delay. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Lag Compensation", meta = (ClampMin = 0.05f, ClampMax = 2.0f))
+	float MaxRewindTime = 0.4f;
+
+	/** Number of snapshots kept to cover MaxRewindTime, which sets the time resolution of the rewind. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Lag Compensation", meta = (ClampMin = 2, ClampMax = 256))
+	int HistoryFrames = 32;
+
+	/** Maximum number of hit volumes recorded in every snapshot. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Lag Compensation", meta = (ClampMin = 4, ClampMax = 1024))
+	int MaxTrackedActors = 64;
+
+	/** Number of the first slots only reserved registrations (players) can take, so active enemies never crowd them out. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Lag Compensation", meta = (ClampMin = 0, ClampMax = 64))
+	int ReservedPlayerSlots = 8;
+
+	/** Time in seconds clients render the interpolated enemies behind their last received sample, added to every rewind. */
+	float InterpolationDelay = 0.0f;
+
+	/** Whether a rejected registration has already been reported in the log. */
+	bool bReportedFullHistory = false;
+
+	/** Number of volume slots in every snapshot, MaxTrackedActors rounded up to the vector width. */
+	int SlotStride = 0;
+
+	/** Index of the most recent snapshot in the ring buffer. */
+	int NewestFrame = INDEX_NONE;
+
+	/** Number of snapshots recorded so far, up to HistoryFrames. */
+	int RecordedFrames = 0;
+
+	/** World time of every snapshot. */
+	TArray<float> FrameTimes = TArray<float>();
+
+	/** X center of every recorded volume, indexed by frame * SlotStride + slot. */
+	TArray<float> CentersX = TArray<float>();
+
+	/** Y center of every recorded volume, indexed by frame * SlotStride + slot. */
+	TArray<float> CentersY = TArray<float>();
+
+	/** Z center of every recorded volume, indexed by frame * SlotStride + slot. */
+	TArray<float> CentersZ = TArray<float>();
+
+	/** X half extent of every recorded volume, indexed by frame * SlotStride + slot. */
+	TArray<float> ExtentsX = TArray<float>();
+
+	/** Y half extent of every recorded volume, indexed by frame * SlotStride + slot. */
+	TArray<float> ExtentsY = TArray<float>();
+
+	/** Z half extent of every recorded volume, indexed by frame * SlotStride + slot. */
+	TArray<float> ExtentsZ = TArray<float>();
+
+	/** Actor recorded in every slot. */
+	TArray<TWeakObjectPtr<AActor>> SlotActors = TArray<TWeakObjectPtr<AActor>>();
+
+	/** Component whose bounds are recorded in every slot. */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> SlotVolumes = TArray<TWeakObjectPtr<UPrimitiveComponent>>();
+
+	/** Slot used by each registered actor. */
+	TMap<const AActor*, int> SlotIndices = TMap<const AActor*, int>();
+
+	/**
+	 * Only creates the subsystem for game and PIE worlds.
+	 * @param WorldType The type of the world the subsystem would be created for.
+	 * @return True if the world type is supported.
+	 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Writes the current bounds of a slot into a snapshot, or an unreachable empty volume if the slot is unused or hidden.
+	 * @param Frame The snapshot to write.
+	 * @param Slot The slot to record.
+	 */
+	void RecordSlot(const int Frame, const int Slot);
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+
+#include "NetActivitySubsystem.generated.h"
+
+/**
+ * FNetActivityEntry
+ *
+ * Replicated actor whose net update frequency and priority are adapted to its activity.
+ */
+struct FNetActivityEntry
+{
+	/** Actor adapted by the entry. */
+	TWeakObjectPtr<AActor> Actor = nullptr;
+
+	/** Net update frequency of the actor when registered, reached when it is active and close to a player. */
+	float BaseFrequency = 0.0f;
+
+	/** Net priority of the actor when registered. */
+	float BasePriority = 1.0f;
+
+	/** Net update frequency last applied to the actor. */
+	float Frequency = 0.0f;
+};
+
+/**
+ * UNetActivitySubsystem
+ *
+ * Server-side world subsystem that adapts the net update frequency and priority of the registered actors to their activity,
+ * instead of replicating every actor at its default frequency.
+ * A few times per second each actor is rated by its distance to the closest player pawn: actors moving towards a player are
+ * raised to their full frequency and a higher priority, while idle or distant actors are lowered down to the minimum frequency.
+ * Raising the frequency forces a net update, so an actor that becomes threatening is not held back by its previous rate.
+ * With the shooter replication graph, the replication period of the actor in the graph is updated as well.
+ * The subsystem also guards the cosmetic events of the actors, dropping them while a client's reliable buffer backs up.
+ */
+UCLASS(config = Game)
+class QORPOTESTJULIAN_API UNetActivitySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Starts adapting the net update frequency and priority of an actor, from their current values.
+	 * Ignored for actors not replicated or without authority.
+	 * @param Actor The actor to adapt.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replication")
+	void RegisterActor(AActor* Actor);
+
+	/**
+	 * Stops adapting an actor, restoring its net update frequency and priority.
+	 * @param Actor The actor to forget.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replication")
+	void UnregisterActor(AActor* Actor);
+
+	/**
+	 * Returns whether a cosmetic event of an actor should be sent to the clients.
+	 * @param Actor The actor sending the event.
+	 * @return False if the reliable buffer of any client channel of the actor is over the watermark.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replication")
+	bool CanSendCosmeticEvent(AActor* Actor);
+
+	/**
+	 * Rates every registered actor once the evaluation interval has elapsed.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns whether there is any actor to adapt on a server. */
+	virtual bool IsTickable() const override;
+
+	/** Returns the stat used to profile the subsystem tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Whether the net update frequency and priority are adapted at all. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	bool bEnableAdaptiveFrequency = true;
+
+	/** Time in seconds between two ratings of the actors. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.05f, ClampMax = 5.0f))
+	float EvaluationInterval = 0.25f;
+
+	/** Distance to the closest player under which an actor keeps its full frequency. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.0f, ClampMax = 100000.0f))
+	float NearDistance = 2000.0f;
+
+	/** Distance to the closest player over which an actor drops to the minimum frequency. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.0f, ClampMax = 100000.0f))
+	float FarDistance = 8000.0f;
+
+	/** Lowest net update frequency an actor is set to. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.5f, ClampMax = 30.0f))
+	float MinNetUpdateFrequency = 2.0f;
+
+	/** Fraction of the distance rating kept by actors that are not moving. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float IdleFrequencyScale = 0.25f;
+
+	/** Multiplier of the base priority of the actors moving towards a player. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 1.0f, ClampMax = 10.0f))
+	float ThreatPriorityScale = 2.0f;
+
+	/** Multiplier of the base priority of the actors at the far distance or beyond. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.1f, ClampMax = 1.0f))
+	float DistantPriorityScale = 0.5f;
+
+	/** Relative change of the rated frequency needed to apply it, so actors near a threshold do not churn. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float FrequencyHysteresis = 0.2f;
+
+	/** Fraction of the reliable buffer of a channel over which the cosmetic events of its actor are dropped. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = 0.1f, ClampMax = 1.0f))
+	float ReliableBufferWatermark = 0.5f;
+
+	/** Actors being adapted. */
+	TArray<FNetActivityEntry> Entries = TArray<FNetActivityEntry>();
+
+	/** Locations of the player pawns gathered for the current rating. */
+	TArray<FVector> ViewerLocations = TArray<FVector>();
+
+	/** Time in seconds until the next rating. */
+	float RemainingTime = 0.0f;
+
+	/**
+	 * Only creates the subsystem for game and PIE worlds.
+	 * @param WorldType The type of the world the subsystem would be created for.
+	 * @return True if the world type is supported.
+	 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Rates the activity of an actor and applies its net update frequency and priority.
+	 * @param Entry The entry of the actor.
+	 * @param Actor The actor to rate.
+	 * @return True if the actor is moving towards a player.
+	 */
+	bool EvaluateActor(FNetActivityEntry& Entry, AActor* Actor);
+
+	/**
+	 * Sets the net update frequency of an actor, in the replication graph too if it is used.
+	 * @param Actor The actor to update.
+	 * @param Frequency The new net update frequency.
+	 */
+	void ApplyFrequency(AActor* Actor, const float Frequency) const;
+};
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "../../Weapons/Public/ProjectileData.h"
+
+#include "ProjectileSubsystem.generated.h"
+
+/**
+ * Delegate broadcast once per simulation pass with every impact produced during that pass.
+ * @param Impacts The impacts resolved in the last simulation pass.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnProjectileImpacts, const TArray<FProjectileImpact>&, Impacts);
+
+/**
+ * FProjectileSimulationState
+ *
+ * Hot data of a simulated projectile, read and written on every simulation pass.
+ * Kept apart from the payload so the movement pass walks a tightly packed array.
+ */
+struct FProjectileSimulationState
+{
+	/** Current world position of the projectile. */
+	FVector Position = FVector::ZeroVector;
+
+	/** Current world velocity of the projectile. */
+	FVector Velocity = FVector::ZeroVector;
+
+	/** Remaining lifetime of the projectile in seconds. */
+	float RemainingLifeTime = 0.0f;
+
+	/** Radius of the sphere swept along the projectile path. */
+	float CollisionRadius = 0.0f;
+
+	/** Index of the instanced visual group drawing the projectile, or INDEX_NONE if it is drawn by its proxy. */
+	int VisualGroup = INDEX_NONE;
+};
+
+/**
+ * FProjectilePayload
+ *
+ * Cold data of a simulated projectile, only read when the projectile impacts or expires.
+ */
+struct FProjectilePayload
+{
+	/** Amount of damage dealt on impact (should be negative for damage). */
+	float Damage = 0.0f;
+
+	/** Actor reported as the damage causer. */
+	TWeakObjectPtr<AActor> Causer = nullptr;
+
+	/** Actor that must never be hit by the projectile. */
+	TWeakObjectPtr<AActor> IgnoredActor = nullptr;
+
+	/** Controller responsible for the damage. */
+	TWeakObjectPtr<AController> Instigator = nullptr;
+
+	/** Optional projectile actor displaying the simulated projectile. */
+	TWeakObjectPtr<ABaseProjectile> Proxy = nullptr;
+
+	/** Handle of the asynchronous sweep issued on the previous pass, if any. */
+	FTraceHandle SweepHandle = FTraceHandle();
+};
+
+/**
+ * FProjectileVisualGroup
+ *
+ * Instance transforms of every simulated projectile drawn with the same projectile class.
+ * Rebuilt on every simulation pass and pushed to its instanced mesh component in a single batch.
+ */
+struct FProjectileVisualGroup
+{
+	/** World transforms of the projectiles of the group, gathered during the current pass. */
+	TArray<FTransform> Transforms = TArray<FTransform>();
+
+	/** Scale of the projectile actors the group replaces. */
+	FVector Scale = FVector::OneVector;
+};
+
+/**
+ * UProjectileSubsystem
+ *
+ * World subsystem that simulates projectiles as plain data instead of individual actors.
+ * Projectiles are stored in contiguous arrays and advanced in a single batched pass per frame using sphere sweeps,
+ * optionally issued asynchronously and resolved on the following frame.
+ * Applies the same damage as ABaseProjectile::ImpactBody and exposes the resulting impacts for cosmetic effects.
+ * Projectiles can be drawn either by their proxy actors or by one instanced static mesh per projectile class.
+ */
+UCLASS(config = Game)
+class QORPOTESTJULIAN_API UProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Event triggered after every simulation pass that produced at least one impact. */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnProjectileImpacts OnProjectileImpacts;
+
+	/** Default constructor. Initializes the sweep query parameters. */
+	UProjectileSubsystem();
+
+	/**
+	 * Starts simulating a new projectile.
+	 * @param Parameters The launch parameters of the projectile.
+	 * @return The index of the projectile in the simulation arrays (only valid until the next pass).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+	int LaunchProjectile(const FProjectileLaunchParameters& Parameters);
+
+	/**
+	 * Stops simulating every projectile displayed by the given proxy, without impact nor deactivation event.
+	 * Used to discard predicted projectiles the server did not confirm.
+	 * @param Proxy The projectile actor displaying the projectiles to cancel.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+	void CancelProjectile(const ABaseProjectile* Proxy);
+
+	/**
+	 * Returns the impacts resolved during the last simulation pass.
+	 * @return The impacts of the last pass.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+	const TArray<FProjectileImpact> GetFrameImpacts() const;
+
+	/**
+	 * Returns the number of projectiles currently simulated.
+	 * @return The active projectile count.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+	const int GetActiveProjectileCount() const;
+
+	/**
+	 * Returns whether projectiles are drawn through instanced meshes instead of their proxy actors.
+	 * @return True if instanced visuals are used.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+	const bool UsesInstancedVisuals() const;
+
+	/**
+	 * Advances every simulated projectile in one batched pass.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns whether the subsystem has any projectile to simulate or instances to clear. */
+	virtual bool IsTickable() const override;
+
+	/** Returns the stat used to profile the subsystem tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Whether sweeps are issued asynchronously and resolved on the following frame. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	bool bUseAsyncSweeps = false;
+
+	/** Whether projectiles are drawn through one instanced static mesh per projectile class instead of their proxy actors. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	bool bUseInstancedVisuals = false;
+
+	/** Impacts resolved during the last simulation pass. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
+	TArray<FProjectileImpact> FrameImpacts = TArray<FProjectileImpact>();
+
+	/** Hot simulation data, one entry per projectile. */
+	TArray<FProjectileSimulationState> States = TArray<FProjectileSimulationState>();
+
+	/** Cold simulation data, one entry per projectile, parallel to States. */
+	TArray<FProjectilePayload> Payloads = TArray<FProjectilePayload>();
+
+	/** Transient actor owning the instanced mesh components of the visual groups. */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
+	AActor* VisualsActor = nullptr;
+
+	/** Instanced mesh components drawing the projectiles, one per visual group. */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
+	TArray<UInstancedStaticMeshComponent*> VisualInstances = TArray<UInstancedStaticMeshComponent*>();
+
+	/** Instance transforms of every visual group, parallel to VisualInstances. */
+	TArray<FProjectileVisualGroup> VisualGroups = TArray<FProjectileVisualGroup>();
+
+	/** Whether any visual group still draws instances that must be cleared on the next pass. */
+	bool bVisualInstancesInUse = false;
+
+	/** Index of the visual group used by each projectile class. */
+	TMap<const UClass*, int> VisualGroupIndices = TMap<const UClass*, int>();
+
+	/** Object types the projectiles can collide with. */
+	FCollisionObjectQueryParams ObjectParams = FCollisionObjectQueryParams(ECC_WorldStatic);
+
+	/**
+	 * Only creates the subsystem for game and PIE worlds.
+	 * @param WorldType The type of the world the subsystem would be created for.
+	 * @return True if the world type is supported.
+	 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Picks the first hit that a projectile is allowed to impact.
+	 * @param Hits The hits returned by the sweep, sorted by distance.
+	 * @param Payload The payload of the swept projectile.
+	 * @return The hit to impact, or nullptr if the path is clear.
+	 */
+	const FHitResult* FindImpactHit(const TArray<FHitResult>& Hits, const FProjectilePayload& Payload) const;
+
+	/**
+	 * Applies the impact of a projectile, records it and removes the projectile from the simulation.
+	 * @param Index The index of the projectile.
+	 * @param Hit The hit that stopped the projectile.
+	 */
+	void ImpactProjectile(const int Index, const FHitResult& Hit);
+
+	/**
+	 * Removes a projectile from the simulation and disables its proxy.
+	 * @param Index The index of the projectile.
+	 */
+	void RemoveProjectile(const int Index);
+
+	/**
+	 * Builds the query parameters used to sweep a projectile.
+	 * @param Payload The payload of the swept projectile.
+	 * @return The query parameters ignoring the projectile's own actors.
+	 */
+	FCollisionQueryParams MakeQueryParams(const FProjectilePayload& Payload) const;
+
+	/**
+	 * Returns the visual group drawing the projectiles of the given proxy's class, creating it if needed.
+	 * @param Proxy The projectile actor whose mesh, materials and scale are instanced.
+	 * @return The index of the visual group, or INDEX_NONE if the proxy has no mesh to instance.
+	 */
+	int FindOrAddVisualGroup(const ABaseProjectile* Proxy);
+
+	/** Moves the proxy actors of the projectiles that are not instanced to their simulated transforms. */
+	void UpdateProxyVisuals();
+
+	/** Gathers the simulated transforms of the instanced projectiles and pushes them to their visual groups in batches. */
+	void UpdateInstancedVisuals();
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "WeaponFireSubsystem.generated.h"
+
+class ABaseWeapon;
+
+/**
+ * FWeaponFireEntry
+ *
+ * Firing state of a weapon whose trigger is active, advanced by the weapon fire subsystem.
+ */
+struct FWeaponFireEntry
+{
+	/** Weapon firing. */
+	TWeakObjectPtr<ABaseWeapon> Weapon = nullptr;
+
+	/** Time in seconds left until the next shot; negative once the shot is due within the current frame. */
+	float RemainingTime = 0.0f;
+};
+
+/**
+ * UWeaponFireSubsystem
+ *
+ * World subsystem that schedules the shots of every weapon with an active trigger in a single ticked pass.
+ * Fire time is accumulated per weapon, so a weapon can fire several shots in one frame, each one told how long ago
+ * within the frame it was due (sub-frame time offset). Weapons that are not firing are not registered and cost nothing.
+ */
+UCLASS(config = Game)
+class QORPOTESTJULIAN_API UWeaponFireSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Registers a weapon whose trigger became active.
+	 * The first shot is delayed until the weapon's cadence allows it again.
+	 * @param Weapon The weapon to fire.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	void StartFiring(ABaseWeapon* Weapon);
+
+	/**
+	 * Unregisters a weapon, cancelling its pending shots.
+	 * @param Weapon The weapon to stop firing.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	void StopFiring(const ABaseWeapon* Weapon);
+
+	/**
+	 * Returns the number of weapons currently firing.
+	 * @return The active trigger count.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	const int GetActiveTriggerCount() const;
+
+	/**
+	 * Advances the fire time of every registered weapon and emits the shots due in this frame.
+	 * @param DeltaTime Time elapsed since the last tick.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns whether any weapon is firing. */
+	virtual bool IsTickable() const override;
+
+	/** Returns the stat used to profile the subsystem tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Maximum number of shots a single weapon can fire in one frame, to bound the work after a hitch. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Weapon", meta = (ClampMin = 1, ClampMax = 100))
+	int MaxShotsPerFrame = 8;
+
+	/** Firing state of every weapon with an active trigger. */
+	TArray<FWeaponFireEntry> Entries = TArray<FWeaponFireEntry>();
+
+	/**
+	 * Only creates the subsystem for game and PIE worlds.
+	 * @param WorldType The type of the world the subsystem would be created for.
+	 * @return True if the world type is supported.
+	 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
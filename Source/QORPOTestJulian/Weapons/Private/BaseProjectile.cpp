@@ -6,29 +6,32 @@
  *
  * This class handles projectile initialization, movement, collision, damage application, and networked state.
  * It is designed to be extended for custom projectile behavior and supports both C++ and Blueprint customization.
+ * Projectiles opting into async physics are stepped by Chaos at a fixed rate; their hits and overlaps are still
+ * dispatched on the game thread by the physics scene, so the impact logic is unchanged.
  */
 
 #include "../Public/BaseProjectile.h"
 #include "../../Core/Public/ShooterPlayerController.h"
 #include "../Public/BaseWeapon.h"
 #include "../../Interactables/Public/ExplosiveBarrel.h"
+#include "../../Subsystems/Public/NetActivitySubsystem.h"
+#include "../../QORPOTestJulian.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 /**
  * Default constructor.
  * Initializes components, sets up collision, movement, and replication properties for the projectile.
+ * Movement is simulated locally on every machine, so neither the actor movement nor the mesh are replicated.
+ * The projectile profile blocks the world, physics bodies and enemies, and only overlaps players and dynamic blockers.
  */
 ABaseProjectile::ABaseProjectile()
 {
 	SetReplicates(true);
-	SetReplicateMovement(true);
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(FName("MeshComponent"));
-	MeshComponent->SetIsReplicated(true);
 	MeshComponent->SetNotifyRigidBodyCollision(true);
-	MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-	MeshComponent->SetCollisionResponseToAllChannels(ECR_Overlap);
-	MeshComponent->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
-	MeshComponent->SetCollisionResponseToChannel(ECC_PhysicsBody, ECR_Block);
+	MeshComponent->SetCollisionProfileName(FName("Projectile"));
 	SetRootComponent(MeshComponent);
 
 	ProjectileMovementComponent = CreateDefaultSubobject<UProjectileMovementComponent>(FName("ProjectileMovementComponent"));
@@ -62,18 +65,41 @@ void ABaseProjectile::SetOwner(AActor* NewOwner)
 /**
  * Called when the game starts or when spawned.
  * Initializes enabled types and disables the projectile by default.
- * Deactivates movement on clients without authority.
+ * Projectiles flying on the async physics step give up their movement component for a gravity-free, undamped CCD body.
  */
 void ABaseProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 
-	Execute_AddEnabledType(this, MeshComponent);
-	Execute_OnTurnEnabled(this, false);
-	if (!HasAuthority() && IsValid(ProjectileMovementComponent))
+	if (UsesAsyncPhysics() && IsValid(MeshComponent))
 	{
-		ProjectileMovementComponent->Deactivate();
+		if (IsValid(ProjectileMovementComponent))
+		{
+			ProjectileMovementComponent->SetAutoActivate(false);
+			ProjectileMovementComponent->Deactivate();
+		}
+
+		MeshComponent->SetEnableGravity(false);
+		MeshComponent->SetLinearDamping(0.0f);
+		MeshComponent->SetUseCCD(true);
 	}
+
+	Execute_AddEnabledType(this, MeshComponent);
+	Execute_OnTurnEnabled(this, false);
+}
+
+/**
+ * Registers properties for network replication.
+ * The visual proxy flag is push based, since it is only set when the projectile is pooled.
+ * @param OutLifetimeProps The array to add replicated properties to.
+ */
+void ABaseProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseProjectile, bVisualProxy, Params);
 }
 
 /**
@@ -85,6 +111,7 @@ void ABaseProjectile::NotifyActorBeginOverlap(AActor* OtherActor)
 {
 	Super::NotifyActorBeginOverlap(OtherActor);
 
+	INC_DWORD_STAT(STAT_GameplayOverlapEvents);
 	ImpactBody(OtherActor);
 }
 
@@ -120,8 +147,36 @@ void ABaseProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	GetWorldTimerManager().ClearTimer(LifeTimeHandle);
 }
 
+/**
+ * Sends the projectile's position, rotation, and enabled state to every machine.
+ * If the cosmetic event guard drops the event, the server only applies it locally and the clients follow the
+ * replicated hidden state of the projectile, flushed before it goes dormant.
+ * A projectile being enabled is woken on the network first, since a pooled projectile is dormant and would drop the event.
+ * @param Position The new world position.
+ * @param Rotation The new world rotation.
+ * @param bEnable Whether the projectile should be enabled.
+ */
+void ABaseProjectile::SendProjectileOut(const FVector& Position, const FRotator& Rotation, const bool bEnable)
+{
+	if (bEnable)
+	{
+		WakePooledActor();
+	}
+
+	UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+	if (!IsValid(NetActivity) || NetActivity->CanSendCosmeticEvent(this))
+	{
+		Multicast_ProjectileOut(Position, Rotation, bEnable);
+	}
+	else
+	{
+		Multicast_ProjectileOut_Implementation(Position, Rotation, bEnable);
+	}
+}
+
 /**
  * Multicast function to update the projectile's position, rotation, and enabled state across the network.
+ * Unreliable, since the replicated hidden state of the projectile converges anyway.
  * @param Position The new world position.
  * @param Rotation The new world rotation.
  * @param bEnable Whether the projectile should be enabled.
@@ -132,19 +187,131 @@ void ABaseProjectile::Multicast_ProjectileOut_Implementation(const FVector& Posi
 	Execute_OnTurnEnabled(this, bEnable);
 }
 
+/**
+ * Enables the projectile locally at the given launch transform, fast-forwarded by the given elapsed time.
+ * Used on every machine to rebuild a shot from its launch record instead of replicating the projectile movement.
+ * The lifetime is shortened by the elapsed time so every machine expires the projectile at the same moment.
+ * @param Position The world position of the launch.
+ * @param Rotation The world rotation of the launch.
+ * @param ElapsedTime Time in seconds already elapsed since the launch (e.g., network latency).
+ */
+void ABaseProjectile::Launch(const FVector& Position, const FRotator& Rotation, const float ElapsedTime)
+{
+	const float Speed = IsValid(ProjectileMovementComponent) && !bVisualProxy ? ProjectileMovementComponent->InitialSpeed : 0.0f;
+	Execute_SetOriginalPositionAndRotation(this, Position + Rotation.Vector() * Speed * ElapsedTime, Rotation);
+	Execute_OnTurnEnabled(this, true);
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	if (ElapsedTime > 0.0f && TimerManager.IsTimerActive(LifeTimeHandle))
+	{
+		TimerManager.SetTimer(LifeTimeHandle, LifeTimeDelegate, FMath::Max(LifeTime - ElapsedTime, KINDA_SMALL_NUMBER), false);
+	}
+}
+
+/**
+ * Sets whether the projectile only displays a projectile simulated by the projectile subsystem.
+ * Visual proxies keep their movement component inactive and their collision disabled.
+ * @param bProxy Whether the projectile should act as a visual proxy.
+ */
+void ABaseProjectile::SetVisualProxy(const bool bProxy)
+{
+	bVisualProxy = bProxy;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABaseProjectile, bVisualProxy, this);
+	if (IsValid(MeshComponent))
+	{
+		CollisionEnabledTypes.FindOrAdd(MeshComponent) = bProxy ? ECollisionEnabled::NoCollision : ECollisionEnabled::QueryAndPhysics;
+		if (bEnableStatus)
+		{
+			MeshComponent->SetCollisionEnabled(CollisionEnabledTypes[MeshComponent].GetValue());
+		}
+	}
+
+	if (bProxy && IsValid(ProjectileMovementComponent))
+	{
+		ProjectileMovementComponent->Deactivate();
+	}
+}
+
+/**
+ * Called when the bVisualProxy property is replicated.
+ * Applies the visual proxy state on clients.
+ */
+void ABaseProjectile::OnReplicateVisualProxy()
+{
+	SetVisualProxy(bVisualProxy);
+}
+
+/**
+ * Builds the parameters needed to simulate this projectile as data from the given launch transform.
+ * The collision radius is taken from the bounds of the projectile mesh.
+ * @param Position The world position of the launch.
+ * @param Rotation The world rotation of the launch.
+ * @return The launch parameters using this projectile's stats, owner and instigator.
+ */
+FProjectileLaunchParameters ABaseProjectile::MakeLaunchParameters(const FVector& Position, const FRotator& Rotation)
+{
+	FProjectileLaunchParameters Parameters = FProjectileLaunchParameters();
+	Parameters.Origin = Position;
+	Parameters.Direction = Rotation.Vector();
+	Parameters.LifeTime = LifeTime;
+	Parameters.Damage = Damage;
+	Parameters.Causer = this;
+	Parameters.IgnoredActor = GetOwner();
+	Parameters.Instigator = GetInstigatorController();
+	Parameters.Proxy = this;
+	if (IsValid(ProjectileMovementComponent))
+	{
+		Parameters.Speed = ProjectileMovementComponent->InitialSpeed;
+	}
+
+	if (IsValid(MeshComponent) && IsValid(MeshComponent->GetStaticMesh()))
+	{
+		Parameters.CollisionRadius = MeshComponent->GetStaticMesh()->GetBounds().SphereRadius * MeshComponent->GetComponentScale().GetMax();
+	}
+
+	return Parameters;
+}
+
+/**
+ * Returns the mesh component displaying the projectile.
+ * @return The mesh component.
+ */
+UStaticMeshComponent* ABaseProjectile::GetMeshComponent() const
+{
+	return MeshComponent;
+}
+
+/**
+ * Returns whether the projectile flies on the async physics step.
+ * @return True if the projectile opted in and async physics is enabled in the project.
+ */
+const bool ABaseProjectile::UsesAsyncPhysics() const
+{
+	return bUseAsyncPhysics && !bVisualProxy && UPhysicsSettings::Get()->bTickPhysicsAsync;
+}
+
 /**
  * Enables or disables the projectile and its movement.
  * Starts or stops the lifetime timer as appropriate.
+ * Runs on every machine, since projectiles are simulated locally from their launch.
+ * Visual proxies are driven by the projectile subsystem, so they only toggle their visibility.
+ * Projectiles on the async physics step toggle their body simulation and launch velocity instead of their movement component.
  * @param bEnabled Whether the projectile should be enabled.
  */
 void ABaseProjectile::OnTurnEnabled_Implementation(const bool bEnabled)
 {
 	IReusableInterface::OnTurnEnabled_Implementation(bEnabled);
 
-	if (!HasAuthority())
+	if (bVisualProxy)
 	{
 		return;
 	}
+	else if (UsesAsyncPhysics() && IsValid(MeshComponent))
+	{
+		const float Speed = IsValid(ProjectileMovementComponent) ? ProjectileMovementComponent->InitialSpeed : 0.0f;
+		MeshComponent->SetSimulatePhysics(bEnabled);
+		MeshComponent->SetPhysicsLinearVelocity(bEnabled ? GetActorForwardVector() * Speed : FVector::ZeroVector);
+	}
 	else if (IsValid(ProjectileMovementComponent))
 	{
 		ProjectileMovementComponent->StopMovementImmediately();
@@ -166,15 +333,23 @@ void ABaseProjectile::OnTurnEnabled_Implementation(const bool bEnabled)
 /**
  * Handles the logic when the projectile impacts another actor.
  * Applies damage and disables the projectile if appropriate.
+ * Other projectiles and pickups never reach this point, since the projectile profile ignores their channels.
+ * Clients only hide their local simulation until the server confirms the impact.
  * @param Actor The actor that was impacted.
  */
 void ABaseProjectile::ImpactBody(AActor* Actor)
 {
-	if (!HasAuthority() || Actor == GetOwner() || IsValid(Cast<ABaseProjectile>(Actor)) || IsValid(Cast<ABaseItem>(Actor)))
+	if (Actor == GetOwner())
 	{
 		return;
 	}
+	else if (!HasAuthority())
+	{
+		Execute_OnTurnEnabled(this, false);
+
+		return;
+	}
 	
 	Execute_DoDamage(this, Actor, Damage, FDamageEvent());
-	Multicast_ProjectileOut(GetActorLocation(), GetActorRotation(), false);
+	SendProjectileOut(GetActorLocation(), GetActorRotation(), false);
 }
\ No newline at end of file
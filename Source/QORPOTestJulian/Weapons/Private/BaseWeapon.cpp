@@ -10,6 +10,9 @@
 
 #include "../Public/BaseWeapon.h"
 #include "../../Characters/Public/ShooterPlayer.h"
+#include "../../Subsystems/Public/WeaponFireSubsystem.h"
+#include "../../Subsystems/Public/NetActivitySubsystem.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 /**
  * Default constructor.
@@ -38,32 +41,38 @@ void ABaseWeapon::SetOwner(AActor* NewOwner)
 }
 
 /**
- * Called when the weapon is spawned or the game starts.
- * Initializes the firing cadence timer.
+ * Registers properties for network replication.
+ * The firing state is push based and only replicated to the owner, the only client predicting the weapon's shots.
+ * @param OutLifetimeProps The array to add replicated properties to.
  */
-void ABaseWeapon::BeginPlay()
+void ABaseWeapon::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-	Super::BeginPlay();
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	GetWorldTimerManager().SetTimer(CadencyTimerHandle, CadencyDelegate, CadencyTime, true);
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	Params.Condition = COND_OwnerOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, ReplicatedMagazine, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, IntervalCount, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, bActiveTrigger, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, ConfirmedShotId, Params);
 }
 
 /**
- * Registers properties for network replication.
- * @param OutLifetimeProps The array to add replicated properties to.
+ * Called when the game starts.
+ * Publishes the initial magazine to the owner.
  */
-void ABaseWeapon::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+void ABaseWeapon::BeginPlay()
 {
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	Super::BeginPlay();
 
-	DOREPLIFETIME(ABaseWeapon, Magazine);
-	DOREPLIFETIME(ABaseWeapon, IntervalCount);
-	DOREPLIFETIME(ABaseWeapon, bActiveTrigger);
+	UpdateReplicatedMagazine();
 }
 
 /**
  * Called every frame.
  * Draws debug lines for aiming if the owner is a valid player.
+ * Discards the predicted shots the server has not confirmed in time.
  * @param DeltaTime Time elapsed since the last tick.
  */
 void ABaseWeapon::Tick(float DeltaTime)
@@ -75,11 +84,27 @@ void ABaseWeapon::Tick(float DeltaTime)
 		DrawDebugLine(GetWorld(), IsValid(MuzzleComponent) ? MuzzleComponent->GetComponentLocation() : GetActorLocation(), 
 			GetAimPosition(), FColor::Red, false, -1.0f, 0, 1.0f);
 	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	const int PredictedCount = PredictedShots.Num();
+	for (int i = PredictedShots.Num() - 1; i >= 0; i--)
+	{
+		if (CurrentTime - PredictedShots[i].Time > PredictionTimeout)
+		{
+			RejectPredictedShot(PredictedShots[i]);
+			PredictedShots.RemoveAt(i);
+		}
+	}
+
+	if (PredictedShots.Num() != PredictedCount)
+	{
+		OnReplicateMagazine();
+	}
 }
 
 /**
  * Called when the weapon is removed from the world.
- * Unbinds events from the owner.
+ * Unbinds events from the owner and stops firing.
  * @param EndPlayReason The reason for removal.
  */
 void ABaseWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -87,6 +112,11 @@ void ABaseWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 
 	SetEvents(GetOwner<AShooterPlayer>());
+	UWeaponFireSubsystem* WeaponFireSubsystem = GetWorld()->GetSubsystem<UWeaponFireSubsystem>();
+	if (IsValid(WeaponFireSubsystem))
+	{
+		WeaponFireSubsystem->StopFiring(this);
+	}
 }
 
 /**
@@ -102,11 +132,86 @@ const FVector ABaseWeapon::GetAimPosition() const
 
 /**
  * Returns the current number of bullets in the magazine.
+ * The owning client gets its predicted magazine.
  * @return The magazine count.
  */
 const int ABaseWeapon::GetMagazine() const
 {
-	return Magazine;
+	return IsPredictingFire() ? PredictedMagazine : Magazine;
+}
+
+/**
+ * Returns whether this machine predicts the shots of the weapon (owning client without authority).
+ * @return True if shots are predicted locally.
+ */
+const bool ABaseWeapon::IsPredictingFire() const
+{
+	const APawn* Pawn = GetOwner<APawn>();
+	return !HasAuthority() && IsValid(Pawn) && Pawn->IsLocallyControlled();
+}
+
+/**
+ * Returns the time in seconds between the last shot and the next one.
+ * Inside a burst this is the burst interval, otherwise the rest of the cadence time, so bursts start every cadence time.
+ * @return The shot interval in seconds.
+ */
+const float ABaseWeapon::GetShotInterval() const
+{
+	if (IntervalProportionTime <= 0.0f || ShotCost <= 1)
+	{
+		return CadencyTime;
+	}
+
+	const float BurstInterval = (CadencyTime / ShotCost) * IntervalProportionTime;
+	return IntervalCount > 0 ? BurstInterval : CadencyTime - BurstInterval * (ShotCost - 1);
+}
+
+/**
+ * Returns the world time in seconds from which the weapon can fire again.
+ * @return The next shot time.
+ */
+const float ABaseWeapon::GetNextShotTime() const
+{
+	return LastShotTime + GetShotInterval();
+}
+
+/**
+ * Fires a shot scheduled by the weapon fire subsystem.
+ * Stores the sub-frame time offset so derived weapons can place the shot where it was due.
+ * @param TimeOffset Time in seconds elapsed since the shot was due within the current frame.
+ * @return True if the weapon fired successfully and keeps firing.
+ */
+bool ABaseWeapon::FireScheduledShot(const float TimeOffset)
+{
+	ShotTimeOffset = TimeOffset;
+	const bool bSuccess = HandleFire();
+	if (bSuccess)
+	{
+		LastShotTime = GetWorld()->GetTimeSeconds() - TimeOffset;
+	}
+
+	ShotTimeOffset = 0.0f;
+
+	return bSuccess;
+}
+
+/**
+ * Returns the number of times the trigger has been pressed on this machine.
+ * @return The trigger sequence.
+ */
+const uint8 ABaseWeapon::GetTriggerSequence() const
+{
+	return TriggerSequence;
+}
+
+/**
+ * Aligns the trigger sequence with the one of the owning client, so the next press starts the given sequence.
+ * The server otherwise counts presses on its own, which diverges when the weapon changes hands or a press is lost.
+ * @param Sequence The trigger sequence the press started on the owning client.
+ */
+void ABaseWeapon::SyncTriggerSequence(const uint8 Sequence)
+{
+	TriggerSequence = Sequence - 1;
 }
 
 /**
@@ -120,7 +225,10 @@ void ABaseWeapon::OnInteract_Implementation(AActor* Caller)
 	if (!IsValid(Caller))
 	{
 		GetWorldTimerManager().ClearTimer(ReloadTimerHandle);
+		IntervalCount = 0;
 		bActiveTrigger = false;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, IntervalCount, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, bActiveTrigger, this);
 		Execute_OnTurnEnabled(this, false);
 		SetInstigator(nullptr);
 
@@ -156,36 +264,52 @@ bool ABaseWeapon::SetEvents(AShooterPlayer* Player, const bool bConnect)
 
 /**
  * Handles the firing logic for the weapon.
- * Manages magazine count, firing cadence, and triggers the fire mechanism.
+ * Manages magazine count, burst count, shot identifiers and triggers the fire mechanism.
+ * A started burst keeps firing after the trigger is released, until all its bullets are spent.
+ * The owning client consumes its predicted magazine and records the shot until the server confirms it,
+ * other clients never fire by themselves.
  * @return True if the weapon fired successfully.
  */
 bool ABaseWeapon::HandleFire_Implementation()
 {
-	FTimerManager& TimerManager = GetWorldTimerManager();
-	const bool bSuccess = (bActiveTrigger || TimerManager.IsTimerActive(IntervalTimerHandle)) && Magazine > 0;
+	const bool bPredicting = IsPredictingFire();
+	int& CurrentMagazine = bPredicting ? PredictedMagazine : Magazine;
+	const bool bSuccess = (HasAuthority() || bPredicting) && (bActiveTrigger || IntervalCount > 0) && CurrentMagazine > 0;
 	if (!bSuccess)
 	{
-		TimerManager.PauseTimer(CadencyTimerHandle);
-		TimerManager.ClearTimer(IntervalTimerHandle);
 		IntervalCount = 0;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, IntervalCount, this);
 
 		return bSuccess;
 	}
 
 	const bool bInterval = IntervalProportionTime > 0.0f && ShotCost > 1;
-	Magazine = FMath::Max(Magazine - (bInterval ? 1 : ShotCost), 0);
-	OnReloaded.Broadcast(0);
-	if (Magazine <= 0 || (bInterval && ++IntervalCount >= ShotCost))
+	const int Cost = FMath::Min(bInterval ? 1 : ShotCost, CurrentMagazine);
+	CurrentMagazine -= Cost;
+	LastShotId = (uint16(TriggerSequence) << 8) | TriggerShotCount++;
+	if (bPredicting)
 	{
-		TimerManager.ClearTimer(IntervalTimerHandle);
-		IntervalCount = 0;
+		FPredictedShot& Shot = PredictedShots.AddDefaulted_GetRef();
+		Shot.ShotId = LastShotId;
+		Shot.Cost = Cost;
+		Shot.Time = GetWorld()->GetTimeSeconds();
+	}
+	else
+	{
+		ConfirmedShotId = LastShotId;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, ConfirmedShotId, this);
+		UpdateReplicatedMagazine();
 	}
-	else if (bInterval && !TimerManager.IsTimerActive(IntervalTimerHandle))
+
+	OnReloaded.Broadcast(0);
+	if (CurrentMagazine <= 0 || (bInterval && ++IntervalCount >= ShotCost))
 	{
-		TimerManager.SetTimer(IntervalTimerHandle, CadencyDelegate, (CadencyTime / ShotCost) * IntervalProportionTime, true);
+		IntervalCount = 0;
 	}
 
-	Multicast_FireMechanism();
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, IntervalCount, this);
+
+	bPredicting ? PlayFireMechanism() : SendFireMechanism();
 
 	return bSuccess;
 }
@@ -207,32 +331,41 @@ void ABaseWeapon::HandleReloadSpent(const int BulletsAmount)
 	ReloadDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(ABaseWeapon, HandleReloadCompleted), BulletsAmount);
 	TimerManager.SetTimer(ReloadTimerHandle, ReloadDelegate, ReloadTime, false);
 	bActiveTrigger = false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, bActiveTrigger, this);
 }
 
 /**
  * Handles the shoot held event, managing trigger state and firing cadence.
+ * Every press starts a new trigger sequence. For a remote owning client the server first adopts the sequence sent with
+ * the press, so both machines build the same shot identifiers even if they counted presses differently.
  * @param bHold True if the shoot button is held, false otherwise.
  */
 void ABaseWeapon::HandleShootHeld(const bool bHold)
 {
 	FTimerManager& TimerManager = GetWorldTimerManager();
-	if (!bHold || Magazine < 1)
+	if (bHold)
 	{
-		bActiveTrigger = false;
-
-		return;
+		TriggerSequence++;
+		TriggerShotCount = 0;
 	}
-	else if (TimerManager.IsTimerActive(ReloadTimerHandle))
-	{
-		bActiveTrigger = true;
 
-		return;
+	bActiveTrigger = bHold && GetMagazine() > 0;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, bActiveTrigger, this);
+	if (bActiveTrigger && !TimerManager.IsTimerActive(ReloadTimerHandle))
+	{
+		ScheduleFire();
 	}
+}
 
-	bActiveTrigger = true;
-	if (TimerManager.IsTimerPaused(CadencyTimerHandle))
+/**
+ * Registers the weapon in the weapon fire subsystem so it starts firing at its cadence.
+ */
+void ABaseWeapon::ScheduleFire()
+{
+	UWeaponFireSubsystem* WeaponFireSubsystem = GetWorld()->GetSubsystem<UWeaponFireSubsystem>();
+	if (IsValid(WeaponFireSubsystem))
 	{
-		TimerManager.UnPauseTimer(CadencyTimerHandle);
+		WeaponFireSubsystem->StartFiring(this);
 	}
 }
 
@@ -244,21 +377,129 @@ void ABaseWeapon::HandleReloadCompleted_Implementation(const int BullettsAmount)
 {
 	const int ResultAmount = FMath::Min(BullettsAmount, MagazineCapacity - Magazine);
 	Magazine += ResultAmount;
+	UpdateReplicatedMagazine();
 	OnReloaded.Broadcast(ResultAmount);
 	if (bActiveTrigger)
 	{
 		GetWorldTimerManager().ClearTimer(ReloadTimerHandle);
-		HandleShootHeld(true);
+		ScheduleFire();
+	}
+}
+
+/**
+ * Sends the fire mechanism to every machine, at most once per frame.
+ * Shots fired in the same frame would only stack the same sound, so they are coalesced into one event.
+ * If the cosmetic event guard drops it, the sound is still played on a listen server.
+ */
+void ABaseWeapon::SendFireMechanism()
+{
+	if (LastFireMechanismFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	LastFireMechanismFrame = GFrameCounter;
+	UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+	if (!IsValid(NetActivity) || NetActivity->CanSendCosmeticEvent(this))
+	{
+		Multicast_FireMechanism();
+	}
+	else if (GetNetMode() != NM_DedicatedServer)
+	{
+		PlayFireMechanism();
 	}
 }
 
 /**
  * Multicast function to play the fire mechanism (e.g., sound) across the network.
+ * Unreliable, since a lost shot sound is harmless. The owning client already played it when predicting the shot.
  */
 void ABaseWeapon::Multicast_FireMechanism_Implementation()
+{
+	if (!IsPredictingFire())
+	{
+		PlayFireMechanism();
+	}
+}
+
+/**
+ * Plays the fire mechanism locally (e.g., sound).
+ */
+void ABaseWeapon::PlayFireMechanism()
 {
 	if (IsValid(AudioComponent))
 	{
 		AudioComponent->Play();
 	}
+}
+
+/**
+ * Called when the magazine or the confirmed shot identifier is replicated.
+ * Restores the magazine from the replicated one on clients, then rebuilds the predicted magazine from the server magazine
+ * and the predicted shots the server has not fired yet, so the owning client never sees its magazine jump back while its shots are in flight.
+ * Derived weapons confirm the predicted shots covered by the confirmed shot identifier first, if they have no other record of them.
+ */
+void ABaseWeapon::OnReplicateMagazine()
+{
+	if (!HasAuthority())
+	{
+		Magazine = ReplicatedMagazine;
+	}
+
+	HandleShotsConfirmed();
+	int PendingCost = 0;
+	for (const FPredictedShot& Shot : PredictedShots)
+	{
+		if (int16(Shot.ShotId - ConfirmedShotId) > 0)
+		{
+			PendingCost += Shot.Cost;
+		}
+	}
+
+	const int CurrentMagazine = FMath::Clamp(Magazine - PendingCost, 0, MagazineCapacity);
+	if (CurrentMagazine != PredictedMagazine)
+	{
+		PredictedMagazine = CurrentMagazine;
+		OnReloaded.Broadcast(0);
+	}
+}
+
+/**
+ * Packs the server magazine into the replicated magazine and marks it dirty for the push model.
+ */
+void ABaseWeapon::UpdateReplicatedMagazine()
+{
+	const uint8 CurrentMagazine = uint8(FMath::Clamp(Magazine, 0, int(MAX_uint8)));
+	if (HasAuthority() && CurrentMagazine != ReplicatedMagazine)
+	{
+		ReplicatedMagazine = CurrentMagazine;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, ReplicatedMagazine, this);
+	}
+}
+
+/**
+ * Removes a predicted shot once the server confirms it.
+ * @param ShotId The identifier of the confirmed shot.
+ * @return True if the shot had been predicted by this machine.
+ */
+bool ABaseWeapon::ConfirmPredictedShot(const uint16 ShotId)
+{
+	return PredictedShots.RemoveAll([ShotId](const FPredictedShot& Shot) { return Shot.ShotId == ShotId; }) > 0;
+}
+
+/**
+ * Called when the confirmed shot identifier is replicated, before the predicted magazine is rebuilt.
+ * Plain weapons wait for a server record of each shot, so nothing is confirmed here.
+ */
+void ABaseWeapon::HandleShotsConfirmed()
+{
+}
+
+/**
+ * Called when a predicted shot times out without being confirmed by the server.
+ * Plain weapons have no cosmetic effect to undo.
+ * @param Shot The rejected shot.
+ */
+void ABaseWeapon::RejectPredictedShot(const FPredictedShot& Shot)
+{
 }
\ No newline at end of file
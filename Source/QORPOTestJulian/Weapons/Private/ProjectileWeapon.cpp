@@ -9,6 +9,10 @@
  */
 
 #include "../Public/ProjectileWeapon.h"
+#include "../../Subsystems/Public/ProjectileSubsystem.h"
+#include "../../Subsystems/Public/NetActivitySubsystem.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 /**
  * Default constructor.
@@ -24,6 +28,7 @@ AProjectileWeapon::AProjectileWeapon() : Super()
 /**
  * Called when the weapon is spawned or the game starts.
  * Spawns and pools all projectiles for this weapon if authority is present.
+ * Pooled projectiles are turned into visual proxies when projectiles are simulated as data.
  */
 void AProjectileWeapon::BeginPlay()
 {
@@ -44,13 +49,33 @@ void AProjectileWeapon::BeginPlay()
 		ABaseProjectile* Projectile = World->SpawnActor<ABaseProjectile>(ProjectileClass, SpawnPosition, SpawnRotation, SpawnParameters);
 		Projectile->AttachToComponent(ProjectilesContainerComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
 		Projectile->SetOwner(this);
+		Projectile->SetVisualProxy(bSimulateProjectilesAsData);
 		ProjectilesContainer.Insert(Projectile, ProjectilesContainer.Num());
 	}
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileWeapon, ProjectilesContainer, this);
+}
+
+/**
+ * Registers properties for network replication.
+ * The pool is push based, since it only changes when it is filled.
+ * @param OutLifetimeProps The array to add replicated properties to.
+ */
+void AProjectileWeapon::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params = FDoRepLifetimeParams();
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AProjectileWeapon, ProjectilesContainer, Params);
 }
 
 /**
  * Handles the firing logic for the weapon.
- * Activates the next available projectile from the pool and fires it from the muzzle location.
+ * Picks the next projectile from the pool and sends its launch record (muzzle transform, server time and pool index)
+ * to every machine, which then simulates the projectile locally.
+ * The launch time is moved back by the sub-frame time offset of the shot, so shots fired in the same frame keep their spacing.
+ * The owning client launches its predicted projectile right away and keeps the record until the server confirms it.
  * @return True if the weapon fired successfully.
  */
 bool AProjectileWeapon::HandleFire_Implementation()
@@ -71,11 +96,27 @@ bool AProjectileWeapon::HandleFire_Implementation()
 		CurrentIndex = Index;
 	}
 
-	if (ProjectilesContainer.IsValidIndex(CurrentIndex) && IsValid(ProjectilesContainer[CurrentIndex]))
+	ABaseProjectile* Projectile = ProjectilesContainer.IsValidIndex(CurrentIndex) ? ProjectilesContainer[CurrentIndex] : nullptr;
+	if (!IsValid(Projectile))
+	{
+		return bSuccess;
+	}
+
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	FProjectileLaunchRecord Record = FProjectileLaunchRecord();
+	Record.Origin = IsValid(MuzzleComponent) ? MuzzleComponent->GetComponentLocation() : GetActorLocation();
+	Record.Rotation = IsValid(MuzzleComponent) ? MuzzleComponent->GetComponentRotation() : GetActorRotation();
+	Record.ServerTime = (IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds()) - ShotTimeOffset;
+	Record.PoolIndex = CurrentIndex;
+	Record.ShotId = LastShotId;
+	if (IsPredictingFire())
 	{
-		ProjectilesContainer[CurrentIndex]->Multicast_ProjectileOut(
-			IsValid(MuzzleComponent) ? MuzzleComponent->GetComponentLocation() : GetActorLocation(),
-			IsValid(MuzzleComponent) ? MuzzleComponent->GetComponentRotation() : GetActorRotation());
+		PredictedRecords.Add(Record.ShotId, Record);
+		LaunchFromRecord(Record);
+	}
+	else
+	{
+		SendLaunchRecord(Record);
 	}
 
 	return bSuccess;
@@ -97,4 +138,123 @@ void AProjectileWeapon::OnInteract_Implementation(AActor* Caller)
 			Projectile->SetOwner(GetOwner());
 		}
 	}
+}
+
+/**
+ * Called when a predicted shot times out without being confirmed by the server.
+ * Removes the predicted projectile.
+ * @param Shot The rejected shot.
+ */
+void AProjectileWeapon::RejectPredictedShot(const FPredictedShot& Shot)
+{
+	FProjectileLaunchRecord Record = FProjectileLaunchRecord();
+	if (PredictedRecords.RemoveAndCopyValue(Shot.ShotId, Record))
+	{
+		CancelProjectile(Record.PoolIndex);
+	}
+}
+
+/**
+ * Sends the launch record of a projectile to every machine.
+ * If the cosmetic event guard drops it, the server still launches the projectile locally, since it deals the damage;
+ * clients miss that projectile, and the owning client removes its predicted one when the shot times out.
+ * @param Record The launch record of the projectile.
+ */
+void AProjectileWeapon::SendLaunchRecord(const FProjectileLaunchRecord& Record)
+{
+	UNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UNetActivitySubsystem>();
+	if (!IsValid(NetActivity) || NetActivity->CanSendCosmeticEvent(this))
+	{
+		Multicast_LaunchProjectile(Record);
+	}
+	else
+	{
+		Multicast_LaunchProjectile_Implementation(Record);
+	}
+}
+
+/**
+ * Multicast function to launch a pooled projectile from its launch record on every machine.
+ * Replaces the per-frame movement replication of the projectile with a one-off record.
+ * Unreliable, since damage is dealt by the server: a lost record only costs a cosmetic projectile on a client.
+ * The owning client reconciles the record with its predicted shot instead of launching a second projectile:
+ * if the server used another pooled projectile, the predicted flight is moved onto it so nothing pops on screen.
+ * @param Record The launch record of the projectile.
+ */
+void AProjectileWeapon::Multicast_LaunchProjectile_Implementation(const FProjectileLaunchRecord& Record)
+{
+	FProjectileLaunchRecord PredictedRecord = FProjectileLaunchRecord();
+	if (!IsPredictingFire() || !PredictedRecords.RemoveAndCopyValue(Record.ShotId, PredictedRecord))
+	{
+		LaunchFromRecord(Record);
+
+		return;
+	}
+
+	ConfirmPredictedShot(Record.ShotId);
+	if (PredictedRecord.PoolIndex == Record.PoolIndex)
+	{
+		return;
+	}
+
+	CancelProjectile(PredictedRecord.PoolIndex);
+	PredictedRecord.PoolIndex = Record.PoolIndex;
+	CurrentIndex = Record.PoolIndex;
+	LaunchFromRecord(PredictedRecord);
+}
+
+/**
+ * Launches a pooled projectile locally from its launch record, fast-forwarded by the time elapsed since the launch
+ * (network latency on clients, sub-frame time offset on the machine that fired it).
+ * When projectiles are simulated as data, the shot is launched into the projectile subsystem,
+ * and the pooled projectile stays hidden if the subsystem draws it through instanced meshes.
+ * @param Record The launch record of the projectile.
+ */
+void AProjectileWeapon::LaunchFromRecord(const FProjectileLaunchRecord& Record)
+{
+	UWorld* World = GetWorld();
+	ABaseProjectile* Projectile = ProjectilesContainer.IsValidIndex(Record.PoolIndex) ? ProjectilesContainer[Record.PoolIndex] : nullptr;
+	if (!IsValid(World) || !IsValid(Projectile))
+	{
+		return;
+	}
+
+	const AGameStateBase* GameState = World->GetGameState();
+	const float ElapsedTime = IsValid(GameState) ? FMath::Max(GameState->GetServerWorldTimeSeconds() - Record.ServerTime, 0.0f) : 0.0f;
+	UProjectileSubsystem* ProjectileSubsystem = bSimulateProjectilesAsData ? World->GetSubsystem<UProjectileSubsystem>() : nullptr;
+	if (!IsValid(ProjectileSubsystem) || !ProjectileSubsystem->UsesInstancedVisuals())
+	{
+		Projectile->Launch(Record.Origin, Record.Rotation, ElapsedTime);
+	}
+
+	if (IsValid(ProjectileSubsystem))
+	{
+		FProjectileLaunchParameters Parameters = Projectile->MakeLaunchParameters(Record.Origin, Record.Rotation);
+		Parameters.Origin += Parameters.Direction * Parameters.Speed * ElapsedTime;
+		Parameters.LifeTime -= ElapsedTime;
+		if (Parameters.LifeTime > 0.0f)
+		{
+			ProjectileSubsystem->LaunchProjectile(Parameters);
+		}
+	}
+}
+
+/**
+ * Stops a pooled projectile locally, both as an actor and in the projectile subsystem.
+ * @param PoolIndex The index of the projectile in the pool.
+ */
+void AProjectileWeapon::CancelProjectile(const int PoolIndex)
+{
+	ABaseProjectile* Projectile = ProjectilesContainer.IsValidIndex(PoolIndex) ? ProjectilesContainer[PoolIndex] : nullptr;
+	if (!IsValid(Projectile))
+	{
+		return;
+	}
+
+	Projectile->Execute_OnTurnEnabled(Projectile, false);
+	UProjectileSubsystem* ProjectileSubsystem = bSimulateProjectilesAsData ? GetWorld()->GetSubsystem<UProjectileSubsystem>() : nullptr;
+	if (IsValid(ProjectileSubsystem))
+	{
+		ProjectileSubsystem->CancelProjectile(Projectile);
+	}
 }
\ No newline at end of file
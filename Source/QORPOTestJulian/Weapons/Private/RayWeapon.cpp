@@ -4,50 +4,207 @@
  * @file RayWeapon.cpp
  * @brief Implements the logic for the ARayWeapon class, which represents a hitscan weapon using line traces for instant impact.
  *
- * This class handles initialization of trace parameters, firing logic using line traces, and applies damage to hit actors.
+ * This class handles initialization of trace parameters, firing logic using synchronous or batched asynchronous line traces
+ * with optional multi-ray spread, resolves remote shots against rewound hit volumes on the server, and applies damage to hit actors.
  * Designed to be extended for custom hitscan weapon behavior and supports both C++ and Blueprint customization.
  */
 
 #include "../Public/RayWeapon.h"
 #include "../../Core/Public/HealEvent.h"
+#include "../../QORPOTestJulian.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ray Weapon Fire"), STAT_RayWeaponFire, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ray Weapon Traces"), STAT_RayWeaponTraces, STATGROUP_QORPOTestJulian);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ray Weapon Rewound Hits"), STAT_RayWeaponRewoundHits, STATGROUP_QORPOTestJulian);
 
  /**
   * Default constructor.
-  * Initializes object query parameters for line tracing and sets up ignored actors.
+  * Initializes object query parameters for line tracing, hitting enemies through their meshes, and sets up ignored actors.
   */
 ARayWeapon::ARayWeapon() : Super()
 {
 	ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
 	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
 	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectParams.AddObjectTypesToQuery(ECC_Enemy);
 	LineTraceParams.AddIgnoredActor(this);
 }
 
 /**
  * Handles the firing logic for the weapon.
- * Performs a line trace from the muzzle or actor location in the forward direction up to MaxRange.
- * Applies damage to the first valid hit actor.
+ * Traces every ray of the shot from the muzzle or actor location up to MaxRange. Rays are spread in a cone seeded by the
+ * shot identifier, so the pattern of a shot can be reproduced from its identifier. Asynchronous rays are queued in the engine's
+ * trace batch of this frame and resolved the following one.
+ * Shots of remote players are also tested against the hit volumes rewound to the time the shooter fired at, and their
+ * world trace gathers every hit so tracked actors at their current positions can be skipped.
+ * Only the server traces: rays deal no damage on clients and have no impact effects, so a predicting client only
+ * consumes its predicted magazine and plays the fire mechanism in the base class.
+ * Pending rewound hits are dropped once every trace is resolved, or once they are older than the rewind window, since
+ * traces resolve the following frame and any older entry belongs to a trace whose result never arrived.
  * @return True if the weapon fired successfully.
  */
 bool ARayWeapon::HandleFire_Implementation()
 {
 	UWorld* World = GetWorld();
 	const bool bSucces = IsValid(World) && Super::HandleFire_Implementation();
-	if (!bSucces)
+	if (!bSucces || !HasAuthority())
 	{
 		return bSucces;
 	}
 
-	FVector PivotPosition = IsValid(MuzzleComponent) ? MuzzleComponent->GetComponentLocation() : GetActorLocation();
-	World->LineTraceSingleByObjectType(LineTraceHitResult, PivotPosition, 
-		PivotPosition + (IsValid(MuzzleComponent) ? MuzzleComponent->GetForwardVector() : GetActorForwardVector()) * MaxRange,
-		ObjectParams, LineTraceParams);
+	SCOPE_CYCLE_COUNTER(STAT_RayWeaponFire);
 
-	AActor* HitActor = LineTraceHitResult.GetActor();
-	if (IsValid(HitActor))
+	ULagCompensationSubsystem* LagCompensation = HasAuthority() ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr;
+	const bool bRewind = IsValid(LagCompensation) && LagCompensation->ShouldRewind(GetInstigatorController());
+	const float ViewTime = bRewind ? LagCompensation->GetViewTime(GetInstigatorController()) - ShotTimeOffset : 0.0f;
+	const EAsyncTraceType TraceType = bRewind ? EAsyncTraceType::Multi : EAsyncTraceType::Single;
+	const float Now = World->GetTimeSeconds();
+	if (PendingRewoundTraces <= 0 || (bRewind && Now - PendingRewoundHitsTime > LagCompensation->GetMaxRewindTime()))
 	{
-		HitActor->TakeDamage(Damage, FDamageEvent(), GetInstigatorController(), this);
+		PendingRewoundHits.Reset();
+		PendingRewoundTraces = 0;
+		PendingRewoundHitsTime = Now;
+	}
+
+	const FVector PivotPosition = IsValid(MuzzleComponent) ? MuzzleComponent->GetComponentLocation() : GetActorLocation();
+	const FVector Direction = IsValid(MuzzleComponent) ? MuzzleComponent->GetForwardVector() : GetActorForwardVector();
+	const float SpreadRadians = FMath::DegreesToRadians(SpreadAngle);
+	FRandomStream SpreadStream = FRandomStream(LastShotId);
+	TArray<FHitResult> Hits = TArray<FHitResult>();
+	for (int i = 0; i < RaysPerShot; i++)
+	{
+		const FVector RayDirection = SpreadRadians > 0.0f ? SpreadStream.VRandCone(Direction, SpreadRadians) : Direction;
+		const FVector EndPosition = PivotPosition + RayDirection * MaxRange;
+		FRewoundHit RewoundHit = FRewoundHit();
+		if (bRewind)
+		{
+			LagCompensation->RewindLineTrace(PivotPosition, EndPosition, ViewTime, GetOwner(), RewoundHit);
+		}
+
+		INC_DWORD_STAT(STAT_RayWeaponTraces);
+		if (bUseAsyncTraces)
+		{
+			const uint32 UserData = bRewind ? uint32(PendingRewoundHits.Add(RewoundHit) + 1) : 0;
+			PendingRewoundTraces += bRewind ? 1 : 0;
+			World->AsyncLineTraceByObjectType(TraceType, PivotPosition, EndPosition, ObjectParams, LineTraceParams, &TraceDelegate, UserData);
+			continue;
+		}
+
+		Hits.Reset();
+		if (bRewind)
+		{
+			World->LineTraceMultiByObjectType(Hits, PivotPosition, EndPosition, ObjectParams, LineTraceParams);
+		}
+		else if (World->LineTraceSingleByObjectType(LineTraceHitResult, PivotPosition, EndPosition, ObjectParams, LineTraceParams))
+		{
+			Hits.Add(LineTraceHitResult);
+		}
+
+		ResolveRay(Hits, bRewind ? &RewoundHit : nullptr);
 	}
 
 	return bSucces;
+}
+
+/**
+ * Called when the weapon is removed from the world.
+ * Drops the rewound hits still waiting for their asynchronous trace.
+ * @param EndPlayReason The reason for removal.
+ */
+void ARayWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	PendingRewoundHits.Empty();
+	PendingRewoundTraces = 0;
+}
+
+/**
+ * Confirms the predicted shots up to the confirmed shot identifier.
+ * Ray shots have no server record, so the replicated identifier is their only confirmation; shots the server has not
+ * fired yet stay predicted, and identifiers are compared with wrap-around.
+ */
+void ARayWeapon::HandleShotsConfirmed()
+{
+	for (int i = PredictedShots.Num() - 1; i >= 0; i--)
+	{
+		const uint16 ShotId = PredictedShots[i].ShotId;
+		if (int16(ShotId - ConfirmedShotId) <= 0)
+		{
+			ConfirmPredictedShot(ShotId);
+		}
+	}
+}
+
+/**
+ * Resolves a ray against the world hits and its rewound hit, if the shot is lag compensated.
+ * Tracked actors can only be hit at their rewound positions; any other hit closer than the rewound one blocks it.
+ * @param Hits The hits of the world trace, sorted by distance.
+ * @param RewoundHit The rewound hit of the ray, or nullptr if the shot is not lag compensated.
+ */
+void ARayWeapon::ResolveRay(const TArray<FHitResult>& Hits, const FRewoundHit* RewoundHit)
+{
+	if (RewoundHit == nullptr)
+	{
+		if (!Hits.IsEmpty())
+		{
+			LineTraceHitResult = Hits[0];
+			ApplyRayHit(LineTraceHitResult);
+		}
+
+		return;
+	}
+
+	const UWorld* World = GetWorld();
+	const ULagCompensationSubsystem* LagCompensation = IsValid(World) ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr;
+	const FHitResult* WorldHit = Hits.FindByPredicate([LagCompensation](const FHitResult& Hit)
+		{
+			return !IsValid(LagCompensation) || !LagCompensation->IsTracked(Hit.GetActor());
+		});
+
+	AActor* RewoundActor = RewoundHit->Actor.Get();
+	if (IsValid(RewoundActor) && (WorldHit == nullptr || RewoundHit->Time < WorldHit->Time))
+	{
+		INC_DWORD_STAT(STAT_RayWeaponRewoundHits);
+		LineTraceHitResult = FHitResult(RewoundActor, nullptr, RewoundHit->Location, FVector::ZeroVector);
+		ApplyRayHit(LineTraceHitResult);
+	}
+	else if (WorldHit != nullptr)
+	{
+		LineTraceHitResult = *WorldHit;
+		ApplyRayHit(LineTraceHitResult);
+	}
+}
+
+/**
+ * Applies the damage of a ray to the actor it hit.
+ * Damage is only applied on the server, predicted shots are cosmetic.
+ * @param Hit The hit result of the ray.
+ */
+void ARayWeapon::ApplyRayHit(const FHitResult& Hit)
+{
+	AActor* HitActor = Hit.GetActor();
+	if (HasAuthority() && IsValid(HitActor))
+	{
+		HitActor->TakeDamage(Damage, FDamageEvent(), GetInstigatorController(), this);
+	}
+}
+
+/**
+ * Called when an asynchronous ray trace is resolved.
+ * Matches the trace with its pending rewound hit through the user data, then resolves the ray.
+ * @param TraceHandle The handle of the resolved trace.
+ * @param TraceDatum The trace data containing the hits.
+ */
+void ARayWeapon::HandleTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const int PendingIndex = int(TraceDatum.UserData) - 1;
+	if (!PendingRewoundHits.IsValidIndex(PendingIndex))
+	{
+		ResolveRay(TraceDatum.OutHits, nullptr);
+		return;
+	}
+
+	PendingRewoundTraces--;
+	ResolveRay(TraceDatum.OutHits, &PendingRewoundHits[PendingIndex]);
 }
\ No newline at end of file
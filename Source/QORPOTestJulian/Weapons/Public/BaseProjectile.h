@@ -3,8 +3,10 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Gameframework/ProjectileMovementComponent.h"
+#include "Net/UnrealNetwork.h"
 #include "../../Core/Public/HealEvent.h"
 #include "../../Interfaces/Public/ReusableInterface.h"
+#include "ProjectileData.h"
 
 #include "BaseProjectile.generated.h"
 
@@ -13,6 +15,10 @@
  *
  * Abstract base class for reusable projectile actors in the game world.
  * Handles projectile initialization, movement, collision, damage application, and networked state.
+ * Movement is not replicated: every machine simulates the projectile locally from its launch, and only the
+ * deactivation is sent by the server.
+ * Optionally, with async physics enabled in the project, the projectile flies as a simulated body stepped at the fixed
+ * async physics rate instead of being moved by its movement component every frame.
  * Designed to be extended for custom projectile behavior and supports both C++ and Blueprint customization.
  */
 UCLASS(Abstract, Blueprintable, BlueprintType)
@@ -30,15 +36,67 @@ public:
 	 */
 	virtual void SetOwner(AActor* NewOwner) override;
 
+	/**
+	 * Sends the projectile's position, rotation, and enabled state to every machine if the cosmetic event guard allows it,
+	 * or only applies it on the server otherwise.
+	 * @param Position The new world position.
+	 * @param Rotation The new world rotation.
+	 * @param bEnable Whether the projectile should be enabled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement")
+	void SendProjectileOut(const FVector& Position, const FRotator& Rotation, const bool bEnable = true);
+
 	/**
 	 * Multicast function to update the projectile's position, rotation, and enabled state across the network.
+	 * Unreliable, since the replicated hidden state of the projectile converges anyway.
 	 * @param Position The new world position.
 	 * @param Rotation The new world rotation.
 	 * @param bEnable Whether the projectile should be enabled.
 	 */
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Movement")
+	UFUNCTION(NetMulticast, Unreliable, BlueprintCallable, Category = "Movement")
 	void Multicast_ProjectileOut(const FVector& Position, const FRotator& Rotation, const bool bEnable = true);
 
+	/**
+	 * Enables the projectile locally at the given launch transform, fast-forwarded by the given elapsed time.
+	 * Used on every machine to rebuild a shot from its launch record instead of replicating the projectile movement.
+	 * @param Position The world position of the launch.
+	 * @param Rotation The world rotation of the launch.
+	 * @param ElapsedTime Time in seconds already elapsed since the launch (e.g., network latency).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement")
+	void Launch(const FVector& Position, const FRotator& Rotation, const float ElapsedTime = 0.0f);
+
+	/**
+	 * Sets whether the projectile only displays a projectile simulated by the projectile subsystem.
+	 * Visual proxies neither move nor collide by themselves.
+	 * @param bProxy Whether the projectile should act as a visual proxy.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement")
+	void SetVisualProxy(const bool bProxy);
+
+	/**
+	 * Builds the parameters needed to simulate this projectile as data from the given launch transform.
+	 * @param Position The world position of the launch.
+	 * @param Rotation The world rotation of the launch.
+	 * @return The launch parameters using this projectile's stats, owner and instigator.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement")
+	FProjectileLaunchParameters MakeLaunchParameters(const FVector& Position, const FRotator& Rotation);
+
+	/**
+	 * Returns the mesh component displaying the projectile.
+	 * @return The mesh component.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components")
+	UStaticMeshComponent* GetMeshComponent() const;
+
+	/**
+	 * Returns whether the projectile flies on the async physics step.
+	 * @return True if the projectile opted in and async physics is enabled in the project.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement")
+	const bool UsesAsyncPhysics() const;
+
 protected:
 	/** Static mesh component representing the projectile's visual appearance and collision. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -60,12 +118,27 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = -1000.0f, ClampMax = -0.1f))
 	float Damage = -20.0f;
 
+	/** Whether the projectile flies as a simulated body on the fixed async physics step, if enabled in the project. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Movement")
+	bool bUseAsyncPhysics = false;
+
+	/** Whether the projectile only displays a projectile simulated by the projectile subsystem. */
+	UPROPERTY(ReplicatedUsing = OnReplicateVisualProxy, VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+	bool bVisualProxy = false;
+
 	/**
 	 * Called when the game starts or when spawned.
 	 * Initializes enabled types and disables the projectile by default.
+	 * Projectiles flying on the async physics step give up their movement component for a gravity-free CCD body.
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * Registers properties for network replication.
+	 * @param OutLifetimeProps The array to add replicated properties to.
+	 */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 	/**
 	 * Called when another actor begins to overlap with this projectile.
 	 * Triggers the impact logic.
@@ -105,11 +178,20 @@ protected:
 	/**
 	 * Handles the logic when the projectile impacts another actor.
 	 * Applies damage and disables the projectile if appropriate.
+	 * Other projectiles and pickups never reach this point, since the projectile profile ignores their channels.
+	 * Clients only hide their local simulation until the server confirms the impact.
 	 * @param Actor The actor that was impacted.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Movement")
 	void ImpactBody(AActor* Actor);
 
+	/**
+	 * Called when the bVisualProxy property is replicated.
+	 * Applies the visual proxy state on clients.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement")
+	void OnReplicateVisualProxy();
+
 private:
 	/** Delegate used internally to manage the projectile's lifetime. */
 	FTimerDelegate LifeTimeDelegate = FTimerDelegate::CreateUFunction(this, GET_FUNCTION_NAME_CHECKED(ABaseProjectile, OnTurnEnabled) ,false);
@@ -14,11 +14,29 @@ class AShooterPlayer;
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnReloaded, const int, Amount);
 
+/**
+ * FPredictedShot
+ *
+ * Shot fired by the owning client ahead of the server, kept until the server confirms it or it times out.
+ */
+struct FPredictedShot
+{
+	/** Identifier of the shot, built the same way by the client and the server (trigger sequence and shot index). */
+	uint16 ShotId = 0;
+
+	/** Number of bullets consumed by the shot. */
+	int Cost = 0;
+
+	/** World time in seconds when the shot was predicted. */
+	float Time = 0.0f;
+};
+
 /**
  * ABaseWeapon
  *
  * Abstract base class for all weapon actors in the game.
  * Handles firing, reloading, magazine management, owner assignment, and network replication.
+ * The owning client predicts its own shots and magazine, and reconciles them with the shots confirmed by the server.
  * Designed to be extended for custom weapon behavior and supports both C++ and Blueprint customization.
  */
 UCLASS(Abstract, Blueprintable, BlueprintType)
@@ -49,11 +67,57 @@ public:
 
 	/**
 	 * Returns the current number of bullets in the magazine.
+	 * The owning client gets its predicted magazine.
 	 * @return The magazine count.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Weapon|Stats")
 	const int GetMagazine() const;
 
+	/**
+	 * Returns whether this machine predicts the shots of the weapon (owning client without authority).
+	 * @return True if shots are predicted locally.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Prediction")
+	const bool IsPredictingFire() const;
+
+	/**
+	 * Returns the time in seconds between the last shot and the next one.
+	 * Inside a burst this is the burst interval, otherwise the rest of the cadence time.
+	 * @return The shot interval in seconds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Stats")
+	const float GetShotInterval() const;
+
+	/**
+	 * Returns the world time in seconds from which the weapon can fire again.
+	 * @return The next shot time.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Stats")
+	const float GetNextShotTime() const;
+
+	/**
+	 * Fires a shot scheduled by the weapon fire subsystem.
+	 * @param TimeOffset Time in seconds elapsed since the shot was due within the current frame.
+	 * @return True if the weapon fired successfully and keeps firing.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|State")
+	bool FireScheduledShot(const float TimeOffset);
+
+	/**
+	 * Returns the number of times the trigger has been pressed on this machine.
+	 * @return The trigger sequence.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Prediction")
+	const uint8 GetTriggerSequence() const;
+
+	/**
+	 * Aligns the trigger sequence with the one of the owning client, so the next press starts the given sequence.
+	 * Called by the server before handling a press of a remote player.
+	 * @param Sequence The trigger sequence the press started on the owning client.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Prediction")
+	void SyncTriggerSequence(const uint8 Sequence);
+
 protected:
 	/** Scene component representing the muzzle location for spawning projectiles. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -67,14 +131,6 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon")
 	FTimerHandle ReloadTimerHandle = FTimerHandle();
 
-	/** Timer handle for managing firing cadence. */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon")
-	FTimerHandle CadencyTimerHandle = FTimerHandle();
-
-	/** Timer handle for managing interval-based firing. */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon")
-	FTimerHandle IntervalTimerHandle = FTimerHandle();
-
 	/** Maximum range of the weapon's projectiles or hitscan. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Stats", meta = (ClampMin = 10.0f, ClampMax = 10000.0f))
 	float MaxRange = 10000.0f;
@@ -87,6 +143,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Stats", meta = (ClampMin = 0.1f, ClampMax = 10.0f))
 	float CadencyTime = 0.2f;
 
+	/** World time in seconds when the last shot was due. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|State")
+	float LastShotTime = TNumericLimits<float>::Lowest();
+
+	/** Time in seconds elapsed since the shot being fired was due within the current frame. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|State")
+	float ShotTimeOffset = 0.0f;
+
 	/** Proportion of the cadence time used for interval-based firing. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Stats", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
 	float IntervalProportionTime = 0.0f;
@@ -99,28 +163,62 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Stats", meta = (ClampMin = 1, ClampMax = 100))
 	int MagazineCapacity = 30;
 
-	/** Current number of bullets in the magazine. Replicated. */
-	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Stats")
+	/** Current number of bullets in the magazine. Replicated to the owner through ReplicatedMagazine. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Stats")
 	int Magazine = MagazineCapacity;
 
-	/** Current interval count for interval-based firing. Replicated. */
+	/** Magazine packed in 8 bits (the capacity is at most 100), pushed to the owner when it changes. */
+	UPROPERTY(ReplicatedUsing = OnReplicateMagazine)
+	uint8 ReplicatedMagazine = 0;
+
+	/** Number of bullets in the magazine as predicted by the owning client. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Prediction")
+	int PredictedMagazine = MagazineCapacity;
+
+	/** Time in seconds after which a predicted shot not confirmed by the server is discarded. Should exceed the round trip time. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Prediction", meta = (ClampMin = 0.1f, ClampMax = 5.0f))
+	float PredictionTimeout = 1.0f;
+
+	/** Number of times the trigger has been pressed, used to build the shot identifiers. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Prediction")
+	uint8 TriggerSequence = 0;
+
+	/** Number of shots fired since the trigger was last pressed, used to build the shot identifiers. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Prediction")
+	uint8 TriggerShotCount = 0;
+
+	/** Identifier of the last shot fired on this machine. */
+	UPROPERTY(VisibleAnywhere, Category = "Weapon|Prediction")
+	uint16 LastShotId = 0;
+
+	/** Identifier of the last shot fired by the server. Replicated to the owner along with the magazine. */
+	UPROPERTY(ReplicatedUsing = OnReplicateMagazine, VisibleAnywhere, Category = "Weapon|Prediction")
+	uint16 ConfirmedShotId = 0;
+
+	/** Frame number when the fire mechanism was last sent, so shots of the same frame share one event. */
+	uint64 LastFireMechanismFrame = 0;
+
+	/** Shots predicted by the owning client and not confirmed yet. */
+	TArray<FPredictedShot> PredictedShots = TArray<FPredictedShot>();
+
+	/** Current interval count for interval-based firing. Replicated to the owner. */
 	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Stats")
 	int IntervalCount = 0;
 
-	/** Whether the weapon's trigger is currently active. Replicated. */
+	/** Whether the weapon's trigger is currently active. Replicated to the owner. */
 	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|State")
 	bool bActiveTrigger = false;
 
-	/** Called when the weapon is spawned or the game starts. Initializes the firing cadence timer. */
-	virtual void BeginPlay() override;
-
 	/** Registers properties for network replication. */
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
-	/** Called every frame. Handles debug drawing and per-frame logic. */
+	/** Called when the game starts. Publishes the initial magazine to the owner. */
+	virtual void BeginPlay() override;
+
+	/** Called every frame. Handles debug drawing, predicted shot timeouts and per-frame logic. */
 	virtual void Tick(float DeltaTime) override;
 
-	/** Called when the weapon is removed from the world. Unbinds events from the owner. */
+	/** Called when the weapon is removed from the world. Unbinds events from the owner and stops firing. */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/**
@@ -141,7 +239,8 @@ protected:
 
 	/**
 	 * Handles the firing logic for the weapon.
-	 * Manages magazine count, firing cadence, and triggers the fire mechanism.
+	 * Manages magazine count, burst count, shot identifiers and triggers the fire mechanism.
+	 * The owning client consumes its predicted magazine and records the shot until the server confirms it.
 	 * @return True if the weapon fired successfully.
 	 */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Weapon|State")
@@ -162,6 +261,12 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Weapon|State")
 	void HandleShootHeld(const bool bHold);
 
+	/**
+	 * Registers the weapon in the weapon fire subsystem so it starts firing at its cadence.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|State")
+	void ScheduleFire();
+
 	/**
 	 * Completes the reload process, updating the magazine count and resuming firing if needed.
 	 * @param BullettsAmount The number of bullets to reload.
@@ -169,15 +274,56 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Weapon|State")
 	void HandleReloadCompleted(const int BullettsAmount);
 
+	/**
+	 * Sends the fire mechanism to every machine, at most once per frame and only if the cosmetic event guard allows it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|State")
+	void SendFireMechanism();
+
 	/**
 	 * Multicast function to play the fire mechanism (e.g., sound) across the network.
+	 * Unreliable, since a lost shot sound is harmless.
 	 */
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Weapon|State")
+	UFUNCTION(NetMulticast, Unreliable, BlueprintCallable, Category = "Weapon|State")
 	void Multicast_FireMechanism();
 
+	/**
+	 * Plays the fire mechanism locally (e.g., sound).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|State")
+	void PlayFireMechanism();
+
+	/**
+	 * Called when the magazine or the confirmed shot identifier is replicated.
+	 * Rebuilds the predicted magazine from the server magazine and the predicted shots the server has not fired yet.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Prediction")
+	void OnReplicateMagazine();
+
+	/** Packs the server magazine into the replicated magazine and marks it dirty for the push model. */
+	void UpdateReplicatedMagazine();
+
+	/**
+	 * Removes a predicted shot once the server confirms it.
+	 * @param ShotId The identifier of the confirmed shot.
+	 * @return True if the shot had been predicted by this machine.
+	 */
+	bool ConfirmPredictedShot(const uint16 ShotId);
+
+	/**
+	 * Called when the confirmed shot identifier is replicated, before the predicted magazine is rebuilt.
+	 * Weapons whose shots have no server record to match confirm their predicted shots here.
+	 */
+	virtual void HandleShotsConfirmed();
+
+	/**
+	 * Called when a predicted shot times out without being confirmed by the server.
+	 * Lets derived weapons undo the cosmetic effects of the shot.
+	 * @param Shot The rejected shot.
+	 */
+	virtual void RejectPredictedShot(const FPredictedShot& Shot);
+
 private:
-	/** Delegate used internally to manage the firing cadence. */
-	const FTimerDelegate CadencyDelegate = FTimerDelegate::CreateUFunction(this, GET_FUNCTION_NAME_CHECKED(ABaseWeapon, HandleFire));
 	/** Delegate used internally to manage the reload process. */
 	FTimerDelegate ReloadDelegate = FTimerDelegate();
 };
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+
+#include "ProjectileData.generated.h"
+
+class ABaseProjectile;
+
+/**
+ * FProjectileLaunchParameters
+ *
+ * Data structure describing a projectile to be simulated by the projectile subsystem.
+ * Contains the launch transform, the ballistic and damage stats, and the actors involved in the shot.
+ *
+ * This struct is designed to be used in both C++ and Blueprints for flexible projectile launching.
+ */
+USTRUCT(BlueprintType)
+struct FProjectileLaunchParameters
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor. Initializes default values for the launch parameters. */
+	FProjectileLaunchParameters() {}
+
+	/** World position where the projectile starts its flight. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch")
+	FVector Origin = FVector::ZeroVector;
+
+	/** Normalized world direction of the projectile flight. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch")
+	FVector Direction = FVector::ForwardVector;
+
+	/** Speed of the projectile in units per second. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch", meta = (ClampMin = 0.0f, ClampMax = 100000.0f))
+	float Speed = 1000.0f;
+
+	/** Maximum lifetime of the projectile in seconds before it is discarded. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch", meta = (ClampMin = 0.0f, ClampMax = 100.0f))
+	float LifeTime = 6.0f;
+
+	/** Radius of the sphere swept along the projectile path. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch", meta = (ClampMin = 0.0f, ClampMax = 1000.0f))
+	float CollisionRadius = 5.0f;
+
+	/** Amount of damage dealt by the projectile on impact (should be negative for damage). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch", meta = (ClampMin = -1000.0f, ClampMax = 0.0f))
+	float Damage = -20.0f;
+
+	/** Actor reported as the damage causer (usually the projectile proxy or the weapon). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch")
+	AActor* Causer = nullptr;
+
+	/** Actor that must never be hit by the projectile (usually the shooting player). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch")
+	AActor* IgnoredActor = nullptr;
+
+	/** Controller responsible for the damage dealt by the projectile. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch")
+	AController* Instigator = nullptr;
+
+	/** Optional projectile actor used only to display the simulated projectile. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Launch")
+	ABaseProjectile* Proxy = nullptr;
+};
+
+/**
+ * FProjectileImpact
+ *
+ * Data structure describing a projectile impact produced by the projectile subsystem.
+ * Gathered once per simulation pass so cosmetic effects can be spawned in a single place.
+ *
+ * This struct is designed to be used in both C++ and Blueprints for flexible impact handling.
+ */
+USTRUCT(BlueprintType)
+struct FProjectileImpact
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor. Initializes default values for the impact. */
+	FProjectileImpact() {}
+
+	/** World position of the impact. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Impact")
+	FVector Location = FVector::ZeroVector;
+
+	/** Surface normal at the impact position. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Impact")
+	FVector Normal = FVector::UpVector;
+
+	/** Actor hit by the projectile, if any. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Impact")
+	AActor* HitActor = nullptr;
+
+	/** Projectile actor that was displaying the simulated projectile, if any. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Impact")
+	ABaseProjectile* Proxy = nullptr;
+};
+
+/**
+ * FProjectileLaunchRecord
+ *
+ * Compact network record of a projectile shot, sent once per projectile instead of replicating its movement.
+ * Clients rebuild the projectile flight locally from the launch origin, the quantized launch rotation and the pool index,
+ * fast-forwarding it by the time elapsed since the server timestamp. The shot identifier lets the shooter reconcile its predicted shots.
+ *
+ * This struct is designed to be used in both C++ and Blueprints for flexible projectile replication.
+ */
+USTRUCT(BlueprintType)
+struct FProjectileLaunchRecord
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor. Initializes default values for the launch record. */
+	FProjectileLaunchRecord() {}
+
+	/** World position where the projectile starts its flight, quantized to centimeters. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Launch")
+	FVector_NetQuantize Origin = FVector_NetQuantize::ZeroVector;
+
+	/** World rotation of the launch, compressed to 16 bits per axis. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Launch")
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Server world time in seconds when the projectile was launched. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Launch")
+	float ServerTime = 0.0f;
+
+	/** Index of the launched projectile in its weapon pool. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Launch")
+	uint16 PoolIndex = 0;
+
+	/** Identifier of the shot that launched the projectile, used by the owning client to match its predicted shots. */
+	UPROPERTY(VisibleAnywhere, Category = "Launch")
+	uint16 ShotId = 0;
+
+	/**
+	 * Serializes the record for network replication using quantized position and rotation.
+	 * @param Ar The archive to serialize to or from.
+	 * @param Map The package map used for object references.
+	 * @param bOutSuccess Set to whether the serialization succeeded.
+	 * @return True, the record is always serialized natively.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		Origin.NetSerialize(Ar, Map, bOutSuccess);
+		Rotation.SerializeCompressedShort(Ar);
+		Ar << ServerTime;
+		Ar << PoolIndex;
+		Ar << ShotId;
+
+		return true;
+	}
+};
+
+/** Type traits enabling the native network serializer of FProjectileLaunchRecord. */
+template<>
+struct TStructOpsTypeTraits<FProjectileLaunchRecord> : public TStructOpsTypeTraitsBase2<FProjectileLaunchRecord>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
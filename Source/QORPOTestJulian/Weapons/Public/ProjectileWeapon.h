@@ -27,8 +27,8 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Projectile")
 	USceneComponent* ProjectilesContainerComponent = nullptr;
 
-	/** Array containing all pooled projectile instances managed by this weapon. */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Projectile")
+	/** Array containing all pooled projectile instances managed by this weapon. Replicated so launch records can refer to them by index. */
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Projectile")
 	TArray<ABaseProjectile*> ProjectilesContainer = TArray<ABaseProjectile*>();
 
 	/** The class type of projectile to spawn and pool. */
@@ -39,15 +39,33 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon|Projectile")
 	int CurrentIndex = -1;
 
+	/**
+	 * Whether fired projectiles are simulated as data by the projectile subsystem.
+	 * Pooled projectiles then only act as visual proxies of the simulated ones.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Projectile")
+	bool bSimulateProjectilesAsData = false;
+
+	/** Launch records of the shots predicted by the owning client, by shot identifier. */
+	TMap<uint16, FProjectileLaunchRecord> PredictedRecords = TMap<uint16, FProjectileLaunchRecord>();
+
 	/**
 	 * Called when the weapon is spawned or the game starts.
 	 * Spawns and pools all projectiles for this weapon if authority is present.
+	 * Pooled projectiles are turned into visual proxies when projectiles are simulated as data.
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * Registers properties for network replication.
+	 * @param OutLifetimeProps The array to add replicated properties to.
+	 */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 	/**
 	 * Handles the firing logic for the weapon.
-	 * Activates the next available projectile from the pool and fires it from the muzzle location.
+	 * Picks the next projectile from the pool and sends its launch record to every machine.
+	 * The owning client launches its predicted projectile right away and keeps the record until the server confirms it.
 	 * @return True if the weapon fired successfully.
 	 */
 	virtual bool HandleFire_Implementation() override;
@@ -58,4 +76,44 @@ protected:
 	 * @param Caller The actor that initiated the interaction.
 	 */
 	virtual void OnInteract_Implementation(AActor* Caller) override;
+
+	/**
+	 * Called when a predicted shot times out without being confirmed by the server.
+	 * Removes the predicted projectile.
+	 * @param Shot The rejected shot.
+	 */
+	virtual void RejectPredictedShot(const FPredictedShot& Shot) override;
+
+	/**
+	 * Sends the launch record of a projectile to every machine, only if the cosmetic event guard allows it.
+	 * @param Record The launch record of the projectile.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Projectile")
+	void SendLaunchRecord(const FProjectileLaunchRecord& Record);
+
+	/**
+	 * Multicast function to launch a pooled projectile from its launch record on every machine.
+	 * Replaces the per-frame movement replication of the projectile with a one-off record.
+	 * Unreliable, since damage is dealt by the server: a lost record only costs a cosmetic projectile on a client.
+	 * The owning client reconciles the record with its predicted shot instead of launching a second projectile.
+	 * @param Record The launch record of the projectile.
+	 */
+	UFUNCTION(NetMulticast, Unreliable, BlueprintCallable, Category = "Weapon|Projectile")
+	void Multicast_LaunchProjectile(const FProjectileLaunchRecord& Record);
+
+	/**
+	 * Launches a pooled projectile locally from its launch record, fast-forwarded by the time elapsed since the launch.
+	 * When projectiles are simulated as data, the shot is launched into the projectile subsystem,
+	 * and the pooled projectile stays hidden if the subsystem draws it through instanced meshes.
+	 * @param Record The launch record of the projectile.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Projectile")
+	void LaunchFromRecord(const FProjectileLaunchRecord& Record);
+
+	/**
+	 * Stops a pooled projectile locally, both as an actor and in the projectile subsystem.
+	 * @param PoolIndex The index of the projectile in the pool.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Projectile")
+	void CancelProjectile(const int PoolIndex);
 };
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "BaseWeapon.h"
+#include "Engine/World.h"
+#include "../../Subsystems/Public/LagCompensationSubsystem.h"
 
 #include "RayWeapon.generated.h"
 
@@ -10,6 +12,10 @@
  *
  * Weapon class that implements hitscan (raycast) firing logic.
  * Uses line traces to instantly detect and apply damage to hit actors along the weapon's firing direction.
+ * Traces can be issued asynchronously so they are resolved in the engine's trace batch and applied the following frame,
+ * and a shot can cast several rays spread in a cone (e.g., shotguns).
+ * On the server, shots of remote players are resolved against the enemy and player positions they were seeing through
+ * the lag compensation subsystem, so they do not have to lead their targets by their ping.
  * Designed to be extended for custom hitscan weapon behavior and supports both C++ and Blueprint customization.
  */
 UCLASS(Blueprintable, BlueprintType)
@@ -26,10 +32,22 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Weapon")
 	FHitResult LineTraceHitResult = FHitResult();
 
-	/** Amount of damage dealt by the weapon on a successful hit (should be negative for damage). */
+	/** Amount of damage dealt by each ray on a successful hit (should be negative for damage). */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon|Stats", meta = (ClampMin = -1000.0f, ClampMax = -0.1f))
 	float Damage = -10.0f;
 
+	/** Half angle in degrees of the cone the rays of a shot are spread in. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Stats", meta = (ClampMin = 0.0f, ClampMax = 45.0f))
+	float SpreadAngle = 0.0f;
+
+	/** Number of rays cast by each shot. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Stats", meta = (ClampMin = 1, ClampMax = 32))
+	int RaysPerShot = 1;
+
+	/** Whether rays are traced asynchronously and their damage applied when the results arrive the following frame. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon")
+	bool bUseAsyncTraces = true;
+
 	/** Object query parameters used for line tracing (defines which object types can be hit). */
 	FCollisionObjectQueryParams ObjectParams = FCollisionObjectQueryParams(ECC_Pawn);
 
@@ -38,9 +56,58 @@ protected:
 
 	/**
 	 * Handles the firing logic for the weapon.
-	 * Performs a line trace from the muzzle or actor location in the forward direction up to MaxRange.
-	 * Applies damage to the first valid hit actor.
+	 * Traces every ray of the shot from the muzzle or actor location up to MaxRange, either right away or queued in
+	 * the asynchronous trace batch, and applies damage to the first valid hit actor of each ray.
+	 * Rays are only traced on the server; predicting clients skip them, since they deal no damage there.
 	 * @return True if the weapon fired successfully.
 	 */
 	virtual bool HandleFire_Implementation() override;
+
+	/**
+	 * Called when the weapon is removed from the world.
+	 * Drops the rewound hits still waiting for their asynchronous trace.
+	 * @param EndPlayReason The reason for removal.
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Confirms the predicted shots up to the confirmed shot identifier.
+	 * Ray shots have no server record, so the replicated identifier is their only confirmation.
+	 */
+	virtual void HandleShotsConfirmed() override;
+
+	/**
+	 * Resolves a ray against the world hits and its rewound hit, if the shot is lag compensated.
+	 * Tracked actors can only be hit at their rewound positions; any other hit closer than the rewound one blocks it.
+	 * @param Hits The hits of the world trace, sorted by distance.
+	 * @param RewoundHit The rewound hit of the ray, or nullptr if the shot is not lag compensated.
+	 */
+	void ResolveRay(const TArray<FHitResult>& Hits, const FRewoundHit* RewoundHit);
+
+	/**
+	 * Applies the damage of a ray to the actor it hit.
+	 * Damage is only applied on the server, predicted shots are cosmetic.
+	 * @param Hit The hit result of the ray.
+	 */
+	void ApplyRayHit(const FHitResult& Hit);
+
+	/**
+	 * Called when an asynchronous ray trace is resolved.
+	 * @param TraceHandle The handle of the resolved trace.
+	 * @param TraceDatum The trace data containing the hits.
+	 */
+	void HandleTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+private:
+	/** Delegate used internally to receive the asynchronous trace results. */
+	FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &ARayWeapon::HandleTraceCompleted);
+
+	/** Rewound hits of the lag compensated rays still waiting for their asynchronous trace, indexed by the trace user data minus one. */
+	TArray<FRewoundHit> PendingRewoundHits = TArray<FRewoundHit>();
+
+	/** Number of lag compensated asynchronous traces not yet resolved. */
+	int PendingRewoundTraces = 0;
+
+	/** World time the oldest pending rewound hit was added at, used to drop traces whose results never arrived. */
+	float PendingRewoundHitsTime = 0.0f;
 };